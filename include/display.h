@@ -2,6 +2,26 @@
 #define _DISPLAY_H
 
 #include "iore_params.h"
+#include "iore_hist.h"
+
+/*****************************************************************************
+ * D E F I N I T I O N S
+ *****************************************************************************/
+
+/* summary of a test at a point of a queue depth sweep */
+typedef struct iore_point
+{
+  int ran; /* whether the test ran at this point, before the deadline */
+  int queue_depth; /* number of transfers in flight in each task */
+  double bandwidth; /* MiB/s over the I/O time of all tasks */
+  double iops; /* transfers per second over the I/O time of all tasks */
+  iore_time_t p50; /* median latency of the transfers */
+  iore_time_t p99; /* 99th percentile latency of the transfers */
+  iore_size_t misalignment; /* shift of the offsets at a point of a
+			       misalignment sweep */
+  double straddles[2]; /* fraction of the transfers straddling block and
+			  stripe boundaries */
+} iore_point_t;
 
 /*****************************************************************************
  * P R O T O T Y P E S                                                       
@@ -17,5 +37,25 @@ void display_fs_info(char *);
 void display_rep_header();
 void display_test_results (access_t, int);
 void display_per_task_results (access_t, int);
+void display_checkpoint_results (iore_time_t, iore_time_t, iore_time_t, int);
+void display_delta_results (int, double);
+void display_alloc_results (int, preallocation_t);
+void display_punch_results (int, iore_size_t, iore_size_t);
+void display_evict_results (int, iore_time_t, iore_size_t, iore_size_t);
+void display_epoch_results (int, iore_time_t, iore_size_t, iore_size_t,
+			    iore_hist_t *);
+void display_append_header ();
+void display_append_results (int, int, iore_time_t, iore_size_t,
+			     iore_hist_t *);
+void display_files_header ();
+void display_files_results (access_t, int, iore_time_t, iore_size_t,
+			    iore_size_t, iore_hist_t *);
+void display_visibility_header ();
+void display_visibility_results (handoff_t, int, iore_size_t, iore_hist_t *);
+void display_md_header ();
+void display_md_results (int, iore_time_t *, iore_time_t *, iore_size_t *);
+void summarize_test (access_t, int, iore_point_t *);
+void display_sweep_results (iore_point_t *, int, iore_params_t *);
+void display_misalignment_results (iore_point_t *, int, iore_params_t *);
 
 #endif /* _DISPLAY_H */
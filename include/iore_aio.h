@@ -24,12 +24,66 @@ typedef struct iore_aio
   iore_size_t
   (*io) (void *, iore_size_t *, iore_size_t, iore_offset_t, access_t,
 	 iore_params_t *);
+  void *
+  (*submit) (void *, iore_size_t *, iore_size_t, iore_offset_t, access_t,
+	     iore_params_t *); /* start a transfer; NULL if not supported */
+  iore_size_t
+  (*wait) (void *, iore_params_t *); /* complete a submitted transfer */
+  void *
+  (*open_append) (iore_params_t *); /* open or create for appends only; NULL
+				       if not supported */
+  iore_size_t
+  (*append) (void *, iore_size_t *, iore_size_t,
+	     iore_params_t *); /* write at the end of the file */
+  void
+  (*allocate) (void *, iore_offset_t, iore_size_t,
+	       iore_params_t *); /* reserve the blocks of a range of a file,
+				    extending it; NULL if not supported */
+  void
+  (*truncate) (void *, iore_size_t, iore_params_t *); /* set the size of a
+							 file */
+  void
+  (*punch) (void *, iore_offset_t, iore_size_t,
+	    iore_params_t *); /* deallocate a range of a file, keeping its
+				 size; NULL if not supported */
+  void
+  (*sync) (void *, iore_params_t *); /* flush the data of a file to stable
+					storage; NULL if not supported */
+  void
+  (*datasync) (void *, iore_params_t *); /* flush the data of a file, and
+					    only the metadata needed to read
+					    it; NULL if not supported */
+  void
+  (*writeback) (void *, iore_offset_t, iore_size_t,
+		iore_params_t *); /* start the write-back of a range of a file,
+				     to its end if the length is zero; NULL if
+				     not supported */
+  void
+  (*drop_cache) (void *, iore_params_t *); /* flush a file and evict it from
+					      the page cache; NULL if not
+					      supported */
+  iore_size_t
+  (*cached) (void *, iore_size_t *,
+	     iore_params_t *); /* bytes of a file resident in the page cache,
+				  setting its size; NULL if not supported */
+  int
+  (*stat) (char *, iore_params_t *); /* get the attributes of a path; zero
+					on success, NULL if not supported */
+  int
+  (*mkdir) (char *, iore_params_t *); /* create a directory */
+  int
+  (*rmdir) (char *, iore_params_t *); /* remove an empty directory */
+  int
+  (*rename) (char *, char *, iore_params_t *); /* rename a path */
+  iore_size_t
+  (*readdir) (char *, iore_params_t *); /* list a directory; returns the
+					   number of entries, or -1 */
 } iore_aio_t;
 
 /******************************************************************************
  * D E C L A R A T I O N S
  ******************************************************************************/
 
-iore_aio_t iore_aio_posix;
+extern iore_aio_t iore_aio_posix;
 
 #endif /* _IORE_AIO_H */
@@ -0,0 +1,60 @@
+#ifndef _IORE_HIST_H
+#define _IORE_HIST_H
+
+#include <mpi.h>
+
+#include "util.h"
+
+/******************************************************************************
+ * D E F I N I T I O N S
+ ******************************************************************************/
+
+#define HIST_SUB_BITS 4 /* log2 of the number of buckets per power of two */
+#define HIST_MAX_BITS 40 /* latencies up to 2^40 ns (about 18 minutes) */
+#define HIST_NUM_BUCKETS ((HIST_MAX_BITS - HIST_SUB_BITS + 2) << HIST_SUB_BITS)
+
+/* log-linear histogram of latencies, with a relative error of about 6% */
+typedef struct iore_hist
+{
+  long long count[HIST_NUM_BUCKETS]; /* number of samples in each bucket */
+  long long total; /* number of samples */
+  iore_time_t sum; /* sum of all samples */
+  iore_time_t min; /* smallest sample */
+  iore_time_t max; /* largest sample */
+} iore_hist_t;
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+/*
+ * Remove all samples of a histogram.
+ */
+void reset_hist (iore_hist_t *);
+
+/*
+ * Add a latency sample, in seconds, to a histogram.
+ */
+void hist_add (iore_hist_t *, iore_time_t);
+
+/*
+ * Add all samples of a histogram to another.
+ */
+void merge_hist (iore_hist_t *, iore_hist_t *);
+
+/*
+ * Merge the histograms of all tasks in a communicator into the master rank.
+ */
+void reduce_hist (iore_hist_t *, iore_hist_t *, MPI_Comm);
+
+/*
+ * Returns the latency, in seconds, at a percentile of a histogram.
+ */
+iore_time_t hist_percentile (iore_hist_t *, double);
+
+/*
+ * Returns the mean latency, in seconds, of a histogram.
+ */
+iore_time_t hist_mean (iore_hist_t *);
+
+#endif /* _IORE_HIST_H */
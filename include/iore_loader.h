@@ -0,0 +1,114 @@
+#ifndef _IORE_LOADER_H
+#define _IORE_LOADER_H
+
+#include <pthread.h>
+
+#include "iore_aio.h"
+#include "iore_params.h"
+#include "iore_rand.h"
+#include "util.h"
+
+/******************************************************************************
+ * D E F I N I T I O N S
+ ******************************************************************************/
+
+/* samples of a dataset sharded over files; sample i is in shard
+   i / samples_per_shard, and samples are stored back to back in a shard */
+typedef struct iore_dataset
+{
+  int num_shards; /* number of shard files */
+  iore_size_t samples_per_shard; /* number of samples in each shard */
+  iore_size_t num_samples; /* number of samples in all shards */
+  iore_size_t min_size; /* size of fixed size samples, or the minimum */
+  iore_size_t size_range; /* number of variable sizes from min_size, or 1 */
+  unsigned long long key; /* key of the generator of the sizes */
+  unsigned long long stream; /* stream of the generator of the sizes */
+  iore_offset_t *offsets; /* offset of each variable size sample in its
+			     shard, or NULL with fixed sizes */
+  iore_size_t max_size; /* size of the largest sample */
+} iore_dataset_t;
+
+/* sample read by a prefetch thread */
+typedef struct iore_fetched
+{
+  iore_size_t sample; /* index of the sample in the dataset */
+  iore_size_t moved; /* amount of data read */
+  iore_time_t latency; /* time to read the sample */
+  int slot; /* buffer holding the sample, until released */
+} iore_fetched_t;
+
+/* pool of threads prefetching the samples of an epoch into a bounded queue;
+   threads take the next position of the task's part of the shuffled order,
+   wait for a free buffer and queue the sample once read */
+typedef struct iore_prefetch
+{
+  iore_dataset_t *dataset; /* dataset of the samples */
+  void **fds; /* open file of each shard */
+  iore_aio_t *backend; /* backend reading the samples */
+  iore_params_t *params; /* parameters of the run */
+  iore_perm_t perm; /* shuffled order of the epoch */
+  iore_size_t next; /* next position in the shuffled order to fetch */
+  iore_size_t last; /* end of the positions of the task */
+  int depth; /* number of buffers, i.e., capacity of the queue */
+  char **buffers; /* buffers of the samples being read or queued */
+  int *free_slots; /* stack of free buffers */
+  int num_free; /* number of free buffers */
+  iore_fetched_t *ready; /* circular queue of samples read */
+  int head; /* first sample in the queue */
+  int count; /* number of samples in the queue */
+  int num_threads; /* number of prefetch threads */
+  int num_done; /* number of threads with no more positions to fetch */
+  pthread_t *threads; /* prefetch threads */
+  pthread_mutex_t lock; /* protects the positions, buffers and queue */
+  pthread_cond_t not_full; /* signaled when a buffer is released */
+  pthread_cond_t not_empty; /* signaled when a sample is queued */
+} iore_prefetch_t;
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+/*
+ * Create a dataset of fixed or uniformly distributed sample sizes.
+ */
+iore_dataset_t *new_dataset (int, iore_size_t, iore_size_t, iore_size_t,
+			     unsigned long long, unsigned long long);
+
+/*
+ * Release a dataset.
+ */
+void free_dataset (iore_dataset_t *);
+
+/*
+ * Returns the offset of a sample in its shard.
+ */
+iore_offset_t sample_offset (iore_dataset_t *, iore_size_t);
+
+/*
+ * Returns the size of a sample.
+ */
+iore_size_t sample_size (iore_dataset_t *, iore_size_t);
+
+/*
+ * Start prefetching a range of positions of a shuffled order of the samples.
+ */
+iore_prefetch_t *new_prefetch (iore_dataset_t *, void **, iore_perm_t *,
+			       iore_size_t, iore_size_t, int, int,
+			       iore_aio_t *, iore_params_t *);
+
+/*
+ * Wait for the next sample read; returns FALSE at the end of the epoch.
+ */
+int next_sample (iore_prefetch_t *, iore_fetched_t *);
+
+/*
+ * Release the buffer of a consumed sample for the prefetch threads.
+ */
+void release_sample (iore_prefetch_t *, iore_fetched_t *);
+
+/*
+ * Join the prefetch threads and release the pool.
+ */
+void close_prefetch (iore_prefetch_t *);
+
+#endif /* _IORE_LOADER_H */
@@ -0,0 +1,113 @@
+#ifndef _IORE_OFFSETS_H
+#define _IORE_OFFSETS_H
+
+#include <mpi.h>
+
+#include "iore_params.h"
+#include "iore_rand.h"
+#include "util.h"
+
+/******************************************************************************
+ * D E F I N I T I O N S
+ ******************************************************************************/
+
+/* lazy generator of the file offsets accessed by a task in a test */
+typedef struct iore_offsets
+{
+  access_pattern_t access_pattern; /* ordering of the offsets */
+  file_layout_t file_layout; /* placement of the transfers in the file */
+  int rank; /* rank whose offsets are generated */
+  int num_tasks; /* number of tasks sharing the file */
+  iore_offset_t first; /* first offset of the task's region in the file */
+  iore_size_t file_size; /* size of the file populated by write tests */
+  iore_size_t block_size; /* amount of data accessed in each segment */
+  iore_size_t transfer_size; /* amount of data accessed in a single request */
+  iore_size_t segment_size; /* distance between the task's segments */
+  iore_size_t per_segment; /* number of transfers in each segment */
+  iore_size_t count; /* number of transfers */
+  iore_size_t next; /* index of the next transfer */
+  iore_size_t limit; /* transfers produced at most, up to count */
+  iore_size_t produced; /* transfers produced so far */
+  iore_size_t stride; /* distance between STRIDED transfers */
+  int global; /* random accesses span the slots of all tasks */
+  iore_size_t base; /* first transfer slot of the task in the permutation */
+  iore_perm_t perm; /* permutation of transfer slots in random accesses */
+
+  /* skewed accesses, sampled with replacement */
+  unsigned long long key; /* key of the counter-based generator */
+  unsigned long long stream; /* stream of the counter-based generator */
+  iore_size_t space; /* number of slots sampled */
+  iore_zipf_t zipf; /* distribution of ZIPFIAN accesses */
+  iore_size_t hot_size; /* number of hot slots in HOTSPOT accesses */
+  double hot_access_fraction; /* fraction of HOTSPOT accesses to hot slots */
+  double stddev; /* deviation of GAUSSIAN accesses in slots */
+
+  /* transfers spread over the files a task keeps open */
+  int num_files; /* number of open files */
+  int file_selection; /* spreading of the transfer slots over the files */
+  iore_perm_t file_perm; /* permutation of the slots in RANDOM_FILES */
+
+  /* delta writes, rewriting the dirty runs of transfer slots only */
+  iore_perm_t dirty_perm; /* permutation of the runs of slots */
+  iore_size_t dirty_run; /* number of slots in each run */
+  iore_size_t dirty_runs; /* runs with a permuted index below it are dirty;
+			     negative if all slots are written */
+
+  /* LOG_STRUCTURED writes, allocating extents from a shared counter */
+  MPI_Win win; /* window of the counter, hosted by the master rank */
+  long long *counter; /* memory of the window, the counter in the master */
+  iore_time_t counter_time; /* time spent allocating extents */
+} iore_offsets_t;
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+/*
+ * Create an offset generator for a task in a test.
+ */
+iore_offsets_t *new_offsets (int, int, access_t, iore_size_t, iore_size_t,
+			     iore_params_t *);
+
+/*
+ * Release an offset generator; collective in LOG_STRUCTURED writes.
+ */
+void free_offsets (iore_offsets_t *);
+
+/*
+ * Get the offset and length of the next transfer; returns FALSE at the end.
+ */
+int next_offset (iore_offsets_t *, iore_offset_t *, iore_size_t *);
+
+/*
+ * Move a transfer to one of the open files; returns the index of the file.
+ */
+int spread_offset (iore_offsets_t *, iore_offset_t *, iore_size_t *);
+
+/*
+ * Returns the size of one of the open files populated by write tests.
+ */
+iore_size_t get_spread_file_size (iore_offsets_t *, int);
+
+/*
+ * Limit the generator to the first transfers of the task.
+ */
+void limit_offsets (iore_offsets_t *, iore_size_t, iore_params_t *);
+
+/*
+ * Check if all tasks split a shared file in transfers of the same size.
+ */
+int uniform_transfers (iore_params_t *);
+
+/*
+ * Check if all tasks access blocks of the same size.
+ */
+int uniform_blocks (iore_params_t *);
+
+/*
+ * Check if a transfer straddles a boundary of units of a size, covering part
+ * of a unit.
+ */
+int straddles_boundary (iore_offset_t, iore_size_t, iore_size_t);
+
+#endif /* _IORE_OFFSETS_H */
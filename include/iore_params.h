@@ -14,13 +14,79 @@ typedef struct iore_params
 {
   int num_tasks; /* number of parallel MPI tasks */
   char api[MAX_STR_LEN]; /* name of the API used for I/O */
+  workload_t workload; /* tests or workload executed in each repetition */
+  char trace_file_name[MAXPATHLEN]; /* binary trace replayed by TRACE_REPLAY */
+  int trace_timing; /* replay at the recorded times, not as fast as possible */
+  char trace_capture_file_name[MAXPATHLEN]; /* prefix of captured traces */
+  int trace_buffer_records; /* records buffered in memory by the capture */
+  int num_checkpoints; /* checkpoints written before the restart read */
+  double compute_time; /* seconds of computation before each checkpoint */
+  int compute_busy; /* compute in a busy loop instead of sleeping */
+  int num_shards; /* number of shard files of the DATA_LOADER dataset */
+  int samples_per_shard; /* number of samples in each shard */
+  iore_size_t sample_size; /* size of the samples, or the minimum size */
+  iore_size_t max_sample_size; /* maximum size of variable size samples */
+  int num_epochs; /* number of epochs over the dataset */
+  int prefetch_threads; /* number of threads prefetching samples in a task */
+  int prefetch_depth; /* samples buffered in the prefetch queue of a task */
+  iore_size_t record_size; /* size of the records of LOG_APPEND and
+			      VISIBILITY */
+  int records_per_task; /* number of records appended by each task */
+  int appenders_per_file; /* tasks appending to each file; 0 for one file */
+  int files_per_task; /* number of files of each task in SMALL_FILES */
+  size_distribution_t file_size_distribution; /* distribution of file sizes */
+  iore_size_t file_size; /* fixed size, minimum or median of the files */
+  iore_size_t max_file_size; /* maximum size of UNIFORM or LOGNORMAL files */
+  double file_size_sigma; /* deviation of the logarithm of LOGNORMAL sizes */
+  char file_size_histogram[MAXPATHLEN]; /* histogram of EMPIRICAL sizes */
+  int tree_depth; /* levels of directories below the METADATA tree root */
+  int tree_fanout; /* subdirectories of each directory above the leaves */
+  int items_per_dir; /* files of each task in each directory of the tree */
+  int unique_dir_per_task; /* each task has its own tree, or all share one */
+  int visibility_records; /* records handed over in each VISIBILITY mode */
+  double visibility_timeout; /* seconds readers poll for a record */
   sharing_policy_t sharing_policy; /* policy for file sharing among tasks */
   access_pattern_t access_pattern; /* ordering patterns for file accesses */
+  file_layout_t file_layout; /* placement of the transfers in a shared file */
+  int segment_count; /* number of segments with a block of each task */
+  double zipf_theta; /* skew of ZIPFIAN accesses */
+  double hot_fraction; /* fraction of the file that is hot in HOTSPOT */
+  double hot_access_fraction; /* fraction of HOTSPOT accesses to hot data */
+  double gaussian_stddev; /* deviation of GAUSSIAN accesses, file fraction */
+  int access_stride; /* distance in transfers between STRIDED accesses */
   iore_size_t *block_sizes; /* total amount of data accessed by tasks */
   iore_size_t *transfer_sizes; /* amount of data accessed in a single request */
   
   int write_test; /* execute the write performance test */
   int read_test; /* execute the read performance test */
+  int mixed_test; /* execute the mixed read/write performance test */
+  double read_fraction; /* fraction of reads among mixed test transfers */
+  preallocation_t preallocation; /* preparation of the written files */
+  int punch_holes; /* punch the written transfers out after the tests */
+  durability_t durability; /* flushing of written data to stable storage */
+  int drop_cache_before_read; /* evict the test files from the page cache
+				 before the read test */
+  iore_size_t sync_interval; /* bytes written by a task between flushes */
+  int open_files_per_task; /* files each task keeps open in the tests */
+  file_selection_t open_file_selection; /* spreading of transfers on them */
+  double dirty_fraction; /* transfers rewritten by writes after the first */
+  dirty_selection_t dirty_selection; /* choice of the rewritten transfers */
+  int dirty_cluster_size; /* transfers in each CLUSTERED run */
+  int update_test; /* execute the read-modify-write update test */
+  iore_size_t update_size; /* bytes of the record updated in each transfer;
+			      0 for a random length */
+  iore_size_t fs_block_size; /* alignment of the windows of update tests */
+  iore_size_t stripe_size; /* stripe size of the file system, for alignment
+			      analysis */
+  iore_size_t misalignment; /* shift of all offsets of the tests */
+  int misalignment_steps; /* sweep shifts 0 up to it times misalignment; 0
+			     to disable */
+  arrival_process_t arrival_process; /* schedule of the transfers issued */
+  double target_iops; /* transfers per second offered by all tasks */
+  iore_size_t target_bandwidth; /* bytes per second offered by all tasks */
+  int burst_size; /* number of transfers arriving together in BURSTY */
+  int queue_depth; /* number of transfers in flight in each task */
+  int max_queue_depth; /* sweep queue depths from 1 up to it; 0 to disable */
 
   int ref_num; /* custom experiment reference number */
   char root_file_name[MAXPATHLEN]; /* full name provided for the test file */
@@ -28,12 +94,14 @@ typedef struct iore_params
   int inter_test_delay; /* delay in seconds before read/write tests */
   int intra_test_barrier; /* sync tasks before and after read/write tests */
   int run_time_limit; /* time soft limit in minutes to complete each run */
+  int stonewall; /* time limit in seconds of each test; 0 for no limit */
   int keep_file; /* keep the test file after test completion */
   int use_existing_file; /* execute read/write tests on existing test files */
   int use_rep_in_file_name; /* use the repetition number in the file name */
   int dir_per_file; /* create an individual directory for each test file */
   int reorder_tasks; /* in read tests, a task reads offsets of other task */
   int reorder_tasks_offset; /* distances in number of ranks for reordering */
+  long long random_seed; /* seed of random accesses; negative to draw one */
 
   /* POSIX specific parameters */
   int single_io_attempt; /* do not retry a transfer if incomplete */
@@ -0,0 +1,75 @@
+#ifndef _IORE_RAND_H
+#define _IORE_RAND_H
+
+#include "util.h"
+
+/******************************************************************************
+ * D E F I N I T I O N S
+ ******************************************************************************/
+
+#define FEISTEL_ROUNDS 4 /* rounds of the Feistel network in permutations */
+
+/* random permutation of the integers in [0, size) */
+typedef struct iore_perm
+{
+  unsigned long long key; /* key of the counter-based generator */
+  unsigned long long stream; /* independent stream of the generator */
+  iore_size_t size; /* number of permuted elements */
+  int half_bits; /* number of bits in each half of the permuted domain */
+} iore_perm_t;
+
+/* Zipf distribution over the integers in [1, size] */
+typedef struct iore_zipf
+{
+  iore_size_t size; /* number of elements */
+  double theta; /* exponent of the distribution */
+  double h_x1; /* integral of the hat function at the first element */
+  double h_n; /* integral of the hat function at the last element */
+  double s; /* squeeze threshold of the rejection */
+} iore_zipf_t;
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+/*
+ * Returns the random 64-bit word at a counter of a stream of the generator.
+ */
+unsigned long long rand_u64 (unsigned long long, unsigned long long,
+			     unsigned long long);
+
+/*
+ * Returns the random double in [0, 1) at a counter of a stream.
+ */
+double rand_double (unsigned long long, unsigned long long,
+		    unsigned long long);
+
+/*
+ * Setup a random permutation of a given size from a key and a stream.
+ */
+void setup_perm (iore_perm_t *, unsigned long long, unsigned long long,
+		 iore_size_t);
+
+/*
+ * Returns the i-th element of a random permutation.
+ */
+iore_size_t permute (iore_perm_t *, iore_size_t);
+
+/*
+ * Returns a normally distributed double from two counters of a stream.
+ */
+double rand_normal (unsigned long long, unsigned long long,
+		    unsigned long long);
+
+/*
+ * Setup a Zipf distribution of a given size and exponent.
+ */
+void setup_zipf (iore_zipf_t *, iore_size_t, double);
+
+/*
+ * Returns a Zipf distributed integer from consecutive counters of a stream.
+ */
+iore_size_t rand_zipf (iore_zipf_t *, unsigned long long, unsigned long long,
+		       unsigned long long);
+
+#endif /* _IORE_RAND_H */
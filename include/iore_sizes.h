@@ -0,0 +1,47 @@
+#ifndef _IORE_SIZES_H
+#define _IORE_SIZES_H
+
+#include "iore_params.h"
+#include "util.h"
+
+/******************************************************************************
+ * D E F I N I T I O N S
+ ******************************************************************************/
+
+/* distribution of the sizes of the files of a SMALL_FILES workload; the size
+   of the i-th file is drawn at counter i of a stream of the generator, so any
+   task computes the size of any file */
+typedef struct iore_sizes
+{
+  size_distribution_t distribution; /* shape of the distribution */
+  iore_size_t min_size; /* fixed size, minimum or median of the sizes */
+  iore_size_t max_size; /* largest size drawn */
+  double sigma; /* deviation of the logarithm of LOGNORMAL sizes */
+  int num_bins; /* number of bins of an EMPIRICAL histogram */
+  iore_size_t *bin_sizes; /* size of the files of each bin */
+  double *bin_cdf; /* cumulative fraction of the files up to each bin */
+  unsigned long long key; /* key of the generator */
+  unsigned long long stream; /* stream of the sizes */
+} iore_sizes_t;
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+/*
+ * Setup the distribution of file sizes of a run, reading the histogram of
+ * EMPIRICAL distributions.
+ */
+iore_sizes_t *new_sizes (iore_params_t *, unsigned long long);
+
+/*
+ * Returns the size of the i-th file.
+ */
+iore_size_t draw_size (iore_sizes_t *, iore_size_t);
+
+/*
+ * Release a distribution of file sizes.
+ */
+void free_sizes (iore_sizes_t *);
+
+#endif /* _IORE_SIZES_H */
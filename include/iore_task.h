@@ -4,11 +4,24 @@
 #include <mpi.h>
 #include <util.h>
 #include <iore_aio.h>
+#include <iore_hist.h>
+#include <iore_trace.h>
 
 /******************************************************************************
  * D E F I N I T I O N S
  ******************************************************************************/
 
+/* latency samples of the reads and writes of a test, and the alignment of
+   its transfers */
+typedef struct iore_samples
+{
+  iore_hist_t latency[2]; /* latency of reads and writes */
+  iore_size_t moved[2]; /* data read and written */
+  iore_size_t transfers; /* transfers of the test */
+  iore_size_t straddles[2]; /* transfers straddling fs_block_size and
+			       stripe_size boundaries */
+} iore_samples_t;
+
 /* execution context of a task */
 typedef struct iore_task
 {
@@ -16,14 +29,33 @@ typedef struct iore_task
   MPI_Comm comm; /* MPI communicator for experiment runs */
   int nprocs; /* number of processes in MPI_COMM_WORLD */
   int rank; /* MPI rank */
+  int thread_level; /* thread support provided by MPI */
   verbosity_t verbosity; /* verbosity level */
   iore_time_t wclock_delta; /* time difference regarding master rank */
   iore_time_t wclock_skew_all; /* time difference across all tasks */
   iore_time_t *timer[NUM_TIMERS]; /* performance timers for all repetitions */
-  iore_size_t *data_moved[2]; /* amount of data moved in read/write tests */
+  iore_size_t *data_moved[NUM_ACCESS]; /* amount of data moved in each test */
+  iore_samples_t samples[NUM_ACCESS]; /* samples of the last test of a type */
+  int tests_run[NUM_ACCESS]; /* tests run by the last repetition */
+  iore_time_t stonewall_time; /* time to stop at the stonewall, or -1 */
+  iore_size_t stonewall_moved; /* data moved before the stonewall */
+  iore_size_t stonewall_count; /* transfers done before the stonewall */
+  iore_size_t wear_out_count; /* transfers of a stonewalled write, or -1 */
+  iore_time_t counter_time; /* time in the extent counter of the last
+			       LOG_STRUCTURED write, or -1 */
+  iore_size_t counter_count; /* extents allocated in that write */
+  iore_size_t update_moved; /* bytes read and written by the last update */
+  iore_time_t sync_time; /* time in the interval flushes of the last test */
+  iore_size_t sync_count; /* interval flushes of the last test */
   iore_aio_t *aio_backend; /* abstract I/O implementation */
   unsigned long long data_signature; /* data signature pattern */
+  unsigned int random_seed; /* seed shared by all tasks at startup */
   char *test_file_name; /* full path of the test file */
+  iore_size_t num_files; /* number of files of all tasks in the last
+			    workload */
+  iore_capture_t *capture; /* capture of the transfers, or NULL */
+  int phase; /* test or phase of a workload being executed */
+  iore_time_t phase_start; /* start time of the phase */
   iore_size_t block_size; /* size of a sequential block of data accessed */
   iore_size_t transfer_size; /* size of I/O requests */
 } iore_task_t;
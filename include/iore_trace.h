@@ -0,0 +1,96 @@
+#ifndef _IORE_TRACE_H
+#define _IORE_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "util.h"
+
+/******************************************************************************
+ * D E F I N I T I O N S
+ ******************************************************************************/
+
+#define TRACE_MAGIC "IORETRC" /* first bytes of a trace file */
+#define TRACE_VERSION 1 /* version of the trace file format */
+#define TRACE_MAX_FILES 32768 /* number of file indexes in a record */
+
+/* header of a binary trace file, followed by its records */
+typedef struct iore_trace_header
+{
+  char magic[8]; /* TRACE_MAGIC, null terminated */
+  uint32_t version; /* TRACE_VERSION */
+  uint32_t record_size; /* size in bytes of each record */
+  uint64_t num_records; /* number of records in the file */
+} iore_trace_header_t;
+
+/* a transfer in a binary trace file, in the byte order of the host */
+typedef struct iore_trace_record
+{
+  int32_t rank; /* rank that issued the transfer */
+  int16_t file; /* index of the file accessed */
+  uint8_t op; /* READ or WRITE */
+  uint8_t phase; /* test or phase of a workload issuing the transfer */
+  int64_t offset; /* file offset */
+  int64_t length; /* amount of data requested */
+  double start; /* issue time in seconds since the start of the phase */
+  double end; /* completion time in seconds since the start of the phase */
+  int64_t result; /* amount of data transferred, or -1 on failure */
+} iore_trace_record_t;
+
+/* trace file mapped in memory */
+typedef struct iore_trace
+{
+  int fd; /* descriptor of the trace file */
+  void *map; /* mapping of the whole file */
+  size_t size; /* size of the mapping */
+  iore_trace_record_t *records; /* records in the mapping */
+  iore_size_t num_records; /* number of records */
+} iore_trace_t;
+
+/* capture of the transfers of a task into a trace file; records are kept in
+   memory during a test, and written to the file between tests */
+typedef struct iore_capture
+{
+  int fd; /* descriptor of the trace file */
+  iore_trace_record_t *buffer; /* records not written yet */
+  uint64_t capacity; /* number of records of the buffer */
+  uint64_t count; /* records in the buffer */
+  uint64_t written; /* records in the trace file */
+  uint64_t stalls; /* writes of a full buffer during a test */
+} iore_capture_t;
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+/*
+ * Map a trace file in memory for reading.
+ */
+iore_trace_t *open_trace (char *);
+
+/*
+ * Unmap and close a trace file.
+ */
+void close_trace (iore_trace_t *);
+
+/*
+ * Create a trace file and start capturing records into it.
+ */
+iore_capture_t *new_capture (char *, iore_size_t);
+
+/*
+ * Add a record to a capture.
+ */
+void capture_record (iore_capture_t *, iore_trace_record_t *);
+
+/*
+ * Write the captured records to the trace file.
+ */
+void flush_capture (iore_capture_t *);
+
+/*
+ * Stop capturing, and close the trace file.
+ */
+void close_capture (iore_capture_t *);
+
+#endif /* _IORE_TRACE_H */
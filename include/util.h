@@ -46,36 +46,156 @@ typedef enum sharing_policy
 /* enumeration of access pattern in terms of file offsets */
 typedef enum access_pattern
   {
-    SEQUENTIAL, RANDOM
+    SEQUENTIAL, RANDOM, ZIPFIAN, HOTSPOT, GAUSSIAN, REVERSE, STRIDED
   } access_pattern_t;
 
-/* enumeration of supported access type tests */
+/* enumeration of the spreading of transfers over the files a task keeps open;
+   ROUND_ROBIN_FILES sends consecutive transfer slots to consecutive files,
+   RANDOM_FILES sends each slot to a random file */
+typedef enum file_selection
+  {
+    ROUND_ROBIN_FILES, RANDOM_FILES
+  } file_selection_t;
+
+/* enumeration of selections of the transfers rewritten by delta checkpoints;
+   SCATTERED picks single transfers, CLUSTERED picks runs of transfers */
+typedef enum dirty_selection
+  {
+    SCATTERED, CLUSTERED
+  } dirty_selection_t;
+
+/* enumeration of placements of the tasks' transfers in a shared file;
+   LOG_STRUCTURED writes take the next free extent of the file from a global
+   counter, so faster tasks write more */
+typedef enum file_layout
+  {
+    CONTIGUOUS, SEGMENTED, INTERLEAVED, LOG_STRUCTURED
+  } file_layout_t;
+
+/* enumeration of the issuing of transfers; CLOSED_LOOP issues a transfer when
+   the previous one completes, the others follow an arrival schedule */
+typedef enum arrival_process
+  {
+    CLOSED_LOOP, FIXED_RATE, POISSON, BURSTY
+  } arrival_process_t;
+
+/* enumeration of workloads; STANDARD runs the write, read and mixed tests,
+   CHECKPOINT_RESTART alternates compute phases with checkpoint writes, and
+   DATA_LOADER reads shuffled samples of sharded files over epochs,
+   LOG_APPEND appends records to shared files opened in append mode,
+   SMALL_FILES writes and reads back many small files per task, METADATA
+   measures the rates of namespace operations in a directory tree, and
+   VISIBILITY measures the delay until other tasks see a written record */
+typedef enum workload
+  {
+    STANDARD, TRACE_REPLAY, CHECKPOINT_RESTART, DATA_LOADER, LOG_APPEND,
+    SMALL_FILES, METADATA, VISIBILITY
+  } workload_t;
+
+/* enumeration of the preparations of the test file before the write test;
+   FALLOCATE reserves the blocks of the file, and SPARSE_FILE sets its size
+   without allocating blocks */
+typedef enum preallocation
+  {
+    NO_PREALLOCATION, FALLOCATE, SPARSE_FILE
+  } preallocation_t;
+
+/* enumeration of the durability of written data; FSYNC and FDATASYNC flush
+   the files at the end of a test, FSYNC_INTERVAL and SYNC_FILE_RANGE also
+   every sync_interval bytes written, the latter starting the write-back
+   only, and DSYNC_OPEN and SYNC_OPEN open the files with O_DSYNC or O_SYNC */
+typedef enum durability
+  {
+    NO_DURABILITY, FSYNC, FSYNC_INTERVAL, FDATASYNC, DSYNC_OPEN, SYNC_OPEN,
+    SYNC_FILE_RANGE
+  } durability_t;
+
+/* enumeration of the ways a VISIBILITY writer hands a record over to the
+   readers: a plain write, a write followed by fsync, or a write between an
+   open and a close of the file */
+typedef enum handoff
+  {
+    HANDOFF_WRITE, HANDOFF_FSYNC, HANDOFF_CLOSE, NUM_HANDOFFS
+  } handoff_t;
+
+/* enumeration of the phases of the METADATA workload, in execution order */
+typedef enum md_phase
+  {
+    MD_MKDIR, MD_CREATE, MD_STAT, MD_OPEN, MD_READDIR, MD_RENAME, MD_UNLINK,
+    MD_RMDIR, NUM_MD_PHASES
+  } md_phase_t;
+
+/* enumeration of distributions of the file sizes of SMALL_FILES; EMPIRICAL
+   sizes follow a histogram read from a file */
+typedef enum size_distribution
+  {
+    FIXED_SIZE, UNIFORM_SIZE, LOGNORMAL_SIZE, EMPIRICAL_SIZE
+  } size_distribution_t;
+
+/* enumeration of supported access type tests; MIXED tests issue both reads
+   and writes, REPLAY tests the reads and writes of a trace, and UPDATE tests
+   read-modify-write the blocks around each transfer */
 typedef enum access
   {
-    READ, WRITE
+    READ, WRITE, MIXED, REPLAY, UPDATE, NUM_ACCESS
   } access_t;
 
 typedef double iore_time_t; /* execution time */
 typedef long long int iore_offset_t; /* file offset */
 typedef long long int iore_size_t; /* sizes in byte units or multiples */
 
-/* enumeration of collected timers; W for write, R for read, and D for delete */
+/* enumeration of collected timers; W for write, R for read, M for mixed, P for
+   trace replay, U for update, D for delete, A for the preallocation before
+   the write test and H for the hole punching after the tests; the SYNC
+   timers of a test time the flush of its files before they are closed */
 enum timer
   {
     W_OPEN_START,
     W_OPEN_STOP,
     W_START,
     W_STOP,
+    W_SYNC_START,
+    W_SYNC_STOP,
     W_CLOSE_START,
     W_CLOSE_STOP,
     R_OPEN_START,
     R_OPEN_STOP,
     R_START,
     R_STOP,
+    R_SYNC_START,
+    R_SYNC_STOP,
     R_CLOSE_START,
     R_CLOSE_STOP,
+    M_OPEN_START,
+    M_OPEN_STOP,
+    M_START,
+    M_STOP,
+    M_SYNC_START,
+    M_SYNC_STOP,
+    M_CLOSE_START,
+    M_CLOSE_STOP,
+    P_OPEN_START,
+    P_OPEN_STOP,
+    P_START,
+    P_STOP,
+    P_SYNC_START,
+    P_SYNC_STOP,
+    P_CLOSE_START,
+    P_CLOSE_STOP,
+    U_OPEN_START,
+    U_OPEN_STOP,
+    U_START,
+    U_STOP,
+    U_SYNC_START,
+    U_SYNC_STOP,
+    U_CLOSE_START,
+    U_CLOSE_STOP,
     D_START,
     D_STOP,
+    A_START,
+    A_STOP,
+    H_START,
+    H_STOP,
     NUM_TIMERS
   };
 
@@ -85,7 +205,7 @@ enum timer
 
 char *current_time_str ();
 iore_time_t current_time ();
-void sync_rand_gen (MPI_Comm);
+unsigned int sync_rand_gen (MPI_Comm);
 char *human_readable (iore_size_t, int);
 char *get_parent_path (char *);
 char *get_file_name (char *);
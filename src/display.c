@@ -8,9 +8,39 @@
 
 #include "display.h"
 #include "iore_task.h"
+#include "iore_hist.h"
 #include "iore_params.h"
 #include "util.h"
 
+/*****************************************************************************
+ * P R O T O T Y P E S
+ *****************************************************************************/
+
+static char *get_access_pattern_name (access_pattern_t);
+static char *get_access_name (access_t);
+static char *get_md_phase_name (md_phase_t);
+static char *get_durability_name (durability_t);
+static int get_first_timer (access_t);
+static void display_sweep_point (access_t, iore_point_t *);
+
+/*****************************************************************************
+ * D E F I N I T I O N S
+ *****************************************************************************/
+
+/* timers of a read, write or mixed test, relative to its first timer */
+enum test_timer
+  {
+    T_OPEN_START,
+    T_OPEN_STOP,
+    T_START,
+    T_STOP,
+    T_SYNC_START,
+    T_SYNC_STOP,
+    T_CLOSE_START,
+    T_CLOSE_STOP,
+    NUM_TEST_TIMERS
+  };
+
 /*****************************************************************************
  * G L O B A L S
  *****************************************************************************/
@@ -172,12 +202,131 @@ display_params (iore_params_t *params)
 
       fprintf(stdout, "\t%s = %d\n", "num_tasks", params->num_tasks);
       fprintf(stdout, "\t%s = %s\n", "api", params->api);
+      if (params->workload == TRACE_REPLAY)
+	{
+	  fprintf(stdout, "\t%s = TRACE_REPLAY\n", "workload");
+	  fprintf(stdout, "\t%s = %s\n", "trace_file_name",
+		  params->trace_file_name);
+	  fprintf(stdout, "\t%s = %s\n", "trace_timing",
+		  (params->trace_timing ? "true" : "false"));
+	}
+      else if (params->workload == CHECKPOINT_RESTART)
+	{
+	  fprintf(stdout, "\t%s = CHECKPOINT_RESTART\n", "workload");
+	  fprintf(stdout, "\t%s = %d\n", "num_checkpoints",
+		  params->num_checkpoints);
+	  fprintf(stdout, "\t%s = %.3f sec\n", "compute_time",
+		  params->compute_time);
+	  fprintf(stdout, "\t%s = %s\n", "compute_busy",
+		  (params->compute_busy ? "true" : "false"));
+	}
+      else if (params->workload == DATA_LOADER)
+	{
+	  fprintf(stdout, "\t%s = DATA_LOADER\n", "workload");
+	  fprintf(stdout, "\t%s = %d\n", "num_shards", params->num_shards);
+	  fprintf(stdout, "\t%s = %d\n", "samples_per_shard",
+		  params->samples_per_shard);
+	  fprintf(stdout, "\t%s = %s", "sample_size",
+		  human_readable(params->sample_size, 2));
+	  if (params->max_sample_size > params->sample_size)
+	    fprintf(stdout, " to %s",
+		    human_readable(params->max_sample_size, 2));
+	  fprintf(stdout, "\n");
+	  fprintf(stdout, "\t%s = %d\n", "num_epochs", params->num_epochs);
+	  fprintf(stdout, "\t%s = %d\n", "prefetch_threads",
+		  params->prefetch_threads);
+	  fprintf(stdout, "\t%s = %d\n", "prefetch_depth",
+		  params->prefetch_depth);
+	}
+      else if (params->workload == LOG_APPEND)
+	{
+	  fprintf(stdout, "\t%s = LOG_APPEND\n", "workload");
+	  fprintf(stdout, "\t%s = %s\n", "record_size",
+		  human_readable(params->record_size, 2));
+	  fprintf(stdout, "\t%s = %d\n", "records_per_task",
+		  params->records_per_task);
+	  if (params->appenders_per_file > 0)
+	    fprintf(stdout, "\t%s = %d\n", "appenders_per_file",
+		    params->appenders_per_file);
+	}
+      else if (params->workload == SMALL_FILES)
+	{
+	  fprintf(stdout, "\t%s = SMALL_FILES\n", "workload");
+	  fprintf(stdout, "\t%s = %d\n", "files_per_task",
+		  params->files_per_task);
+	  if (params->file_size_distribution == FIXED_SIZE)
+	    fprintf(stdout, "\t%s = %s\n", "file_size",
+		    human_readable(params->file_size, 2));
+	  else if (params->file_size_distribution == UNIFORM_SIZE)
+	    {
+	      fprintf(stdout, "\t%s = UNIFORM\n", "file_size_distribution");
+	      fprintf(stdout, "\t%s = %s", "file_size",
+		      human_readable(params->file_size, 2));
+	      fprintf(stdout, " to %s\n",
+		      human_readable(params->max_file_size, 2));
+	    }
+	  else if (params->file_size_distribution == LOGNORMAL_SIZE)
+	    {
+	      fprintf(stdout, "\t%s = LOGNORMAL\n", "file_size_distribution");
+	      fprintf(stdout, "\t%s = %s median, sigma %.3f\n", "file_size",
+		      human_readable(params->file_size, 2),
+		      params->file_size_sigma);
+	      fprintf(stdout, "\t%s = %s\n", "max_file_size",
+		      human_readable(params->max_file_size, 2));
+	    }
+	  else
+	    {
+	      fprintf(stdout, "\t%s = EMPIRICAL\n", "file_size_distribution");
+	      fprintf(stdout, "\t%s = %s\n", "file_size_histogram",
+		      params->file_size_histogram);
+	    }
+	}
+      else if (params->workload == METADATA)
+	{
+	  fprintf(stdout, "\t%s = METADATA\n", "workload");
+	  fprintf(stdout, "\t%s = %d\n", "tree_depth", params->tree_depth);
+	  fprintf(stdout, "\t%s = %d\n", "tree_fanout", params->tree_fanout);
+	  fprintf(stdout, "\t%s = %d\n", "items_per_dir",
+		  params->items_per_dir);
+	  fprintf(stdout, "\t%s = %s\n", "unique_dir_per_task",
+		  (params->unique_dir_per_task ? "true" : "false"));
+	}
+      else if (params->workload == VISIBILITY)
+	{
+	  fprintf(stdout, "\t%s = VISIBILITY\n", "workload");
+	  fprintf(stdout, "\t%s = %s\n", "record_size",
+		  human_readable(params->record_size, 2));
+	  fprintf(stdout, "\t%s = %d\n", "visibility_records",
+		  params->visibility_records);
+	  fprintf(stdout, "\t%s = %.3f sec\n", "visibility_timeout",
+		  params->visibility_timeout);
+	}
       fprintf(stdout, "\t%s = %s\n", "sharing_policy",
 	      (params->sharing_policy == SHARED_FILE ) ?
 	      "SHARED_FILE" : "FILE_PER_PROCESS");
       fprintf(stdout, "\t%s = %s\n", "access_pattern",
-	      (params->access_pattern == SEQUENTIAL ) ?
-	      "SEQUENTIAL" : "RANDOM");
+	      get_access_pattern_name (params->access_pattern));
+      if (params->access_pattern == ZIPFIAN)
+	fprintf(stdout, "\t%s = %.3f\n", "zipf_theta", params->zipf_theta);
+      else if (params->access_pattern == HOTSPOT)
+	{
+	  fprintf(stdout, "\t%s = %.3f\n", "hot_fraction",
+		  params->hot_fraction);
+	  fprintf(stdout, "\t%s = %.3f\n", "hot_access_fraction",
+		  params->hot_access_fraction);
+	}
+      else if (params->access_pattern == GAUSSIAN)
+	fprintf(stdout, "\t%s = %.3f\n", "gaussian_stddev",
+		params->gaussian_stddev);
+      else if (params->access_pattern == STRIDED)
+	fprintf(stdout, "\t%s = %d\n", "access_stride", params->access_stride);
+      if (params->sharing_policy == SHARED_FILE)
+	fprintf(stdout, "\t%s = %s\n", "file_layout",
+		(params->file_layout == CONTIGUOUS) ? "CONTIGUOUS" :
+		(params->file_layout == SEGMENTED) ? "SEGMENTED" :
+		(params->file_layout == INTERLEAVED) ? "INTERLEAVED" :
+		"LOG_STRUCTURED");
+      fprintf(stdout, "\t%s = %d\n", "segment_count", params->segment_count);
 
       fprintf(stdout, "\t%s = { %s", "block_sizes",
 	      human_readable(params->block_sizes[0], 2));
@@ -196,14 +345,116 @@ display_params (iore_params_t *params)
 	  fprintf(stdout, "\t%s = write", "test");
 	  if (params->read_test)
 	    fprintf(stdout, ", read");
+	  if (params->mixed_test)
+	    fprintf(stdout, ", mixed");
+	  if (params->update_test)
+	    fprintf(stdout, ", update");
 	  fprintf(stdout, "\n");
 	}
       else if (params->read_test)
 	{
-	  fprintf(stdout, "\t%s = read\n", "test");
+	  fprintf(stdout, "\t%s = read", "test");
+	  if (params->mixed_test)
+	    fprintf(stdout, ", mixed");
+	  if (params->update_test)
+	    fprintf(stdout, ", update");
+	  fprintf(stdout, "\n");
+	}
+      else if (params->mixed_test)
+	{
+	  fprintf(stdout, "\t%s = mixed", "test");
+	  if (params->update_test)
+	    fprintf(stdout, ", update");
+	  fprintf(stdout, "\n");
+	}
+      else if (params->update_test)
+	{
+	  fprintf(stdout, "\t%s = update\n", "test");
+	}
+      if (params->mixed_test)
+	fprintf(stdout, "\t%s = %.3f\n", "read_fraction",
+		params->read_fraction);
+      if (params->preallocation != NO_PREALLOCATION)
+	fprintf(stdout, "\t%s = %s\n", "preallocation",
+		(params->preallocation == FALLOCATE) ? "FALLOCATE" : "SPARSE");
+      if (params->punch_holes)
+	fprintf(stdout, "\t%s = true\n", "punch_holes");
+      if (params->durability != NO_DURABILITY)
+	fprintf(stdout, "\t%s = %s\n", "durability",
+		get_durability_name (params->durability));
+      if (params->durability == FSYNC_INTERVAL ||
+	  params->durability == SYNC_FILE_RANGE)
+	fprintf(stdout, "\t%s = %s\n", "sync_interval",
+		human_readable(params->sync_interval, 2));
+      if (params->drop_cache_before_read)
+	fprintf(stdout, "\t%s = true\n", "drop_cache_before_read");
+      if (params->open_files_per_task > 1)
+	{
+	  fprintf(stdout, "\t%s = %d\n", "open_files_per_task",
+		  params->open_files_per_task);
+	  fprintf(stdout, "\t%s = %s\n", "open_file_selection",
+		  (params->open_file_selection == ROUND_ROBIN_FILES) ?
+		  "ROUND_ROBIN" : "RANDOM");
+	}
+      if (params->dirty_fraction < 1)
+	{
+	  fprintf(stdout, "\t%s = %.3f\n", "dirty_fraction",
+		  params->dirty_fraction);
+	  fprintf(stdout, "\t%s = %s\n", "dirty_selection",
+		  (params->dirty_selection == SCATTERED) ? "SCATTERED" :
+		  "CLUSTERED");
+	  if (params->dirty_selection == CLUSTERED)
+	    fprintf(stdout, "\t%s = %d\n", "dirty_cluster_size",
+		    params->dirty_cluster_size);
+	}
+      if (params->update_test)
+	fprintf(stdout, "\t%s = %s\n", "update_size",
+		(params->update_size > 0) ?
+		human_readable(params->update_size, 2) : "random");
+      if (params->update_test || params->misalignment_steps > 0)
+	fprintf(stdout, "\t%s = %s\n", "fs_block_size",
+		human_readable(params->fs_block_size, 2));
+      if (params->misalignment_steps > 0)
+	{
+	  fprintf(stdout, "\t%s = %s\n", "stripe_size",
+		  human_readable(params->stripe_size, 2));
+	  fprintf(stdout, "\t%s = %d\n", "misalignment_steps",
+		  params->misalignment_steps);
+	}
+      if (params->misalignment > 0)
+	fprintf(stdout, "\t%s = %s\n", "misalignment",
+		human_readable(params->misalignment, 2));
+
+      if (params->arrival_process != CLOSED_LOOP)
+	{
+	  fprintf(stdout, "\t%s = %s\n", "arrival_process",
+		  (params->arrival_process == FIXED_RATE) ? "FIXED_RATE" :
+		  (params->arrival_process == POISSON) ? "POISSON" : "BURSTY");
+	  if (params->target_iops > 0)
+	    fprintf(stdout, "\t%s = %.1f\n", "target_iops",
+		    params->target_iops);
+	  else
+	    fprintf(stdout, "\t%s = %s/s\n", "target_bandwidth",
+		    human_readable(params->target_bandwidth, 2));
+	  if (params->arrival_process == BURSTY)
+	    fprintf(stdout, "\t%s = %d\n", "burst_size", params->burst_size);
 	}
 
+      if (params->max_queue_depth > 0)
+	fprintf(stdout, "\t%s = %d\n", "max_queue_depth",
+		params->max_queue_depth);
+      else
+	fprintf(stdout, "\t%s = %d\n", "queue_depth", params->queue_depth);
+
       fprintf(stdout, "\t%s = %s\n", "root_file_name", params->root_file_name);
+      if (params->trace_capture_file_name[0] != '\0')
+	{
+	  fprintf(stdout, "\t%s = %s\n", "trace_capture_file_name",
+		  params->trace_capture_file_name);
+	  fprintf(stdout, "\t%s = %d\n", "trace_buffer_records",
+		  params->trace_buffer_records);
+	}
+      fprintf(stdout, "\t%s = %lld\n", "random_seed", params->random_seed);
 
       if (task->verbosity >= VERBOSE)
 	{
@@ -215,6 +466,7 @@ display_params (iore_params_t *params)
 		  (params->intra_test_barrier ? "true" : "false"));
 	  fprintf(stdout, "\t%s = %d min\n", "run_time_limit",
 		  params->run_time_limit);
+	  fprintf(stdout, "\t%s = %d sec\n", "stonewall", params->stonewall);
 	  fprintf(stdout, "\t%s = %s\n", "keep_file",
 		  (params->keep_file ? "true" : "false"));
 	  fprintf(stdout, "\t%s = %s\n", "use_existing_file",
@@ -307,93 +559,809 @@ display_rep_header()
 {
   if (task->verbosity >= NORMAL && task->rank == MASTER_RANK)
     {
-      fprintf(stdout, "%s %10s  %12s  %10s  %12s  %12s %5s\n", "access",
-	      "open(s)","io(s)", "close(s)", "total(s)", "tput(MiB/s)", "iter");
+      fprintf(stdout, "%s %10s  %12s  %10s  %10s  %12s  %12s %5s\n",
+	      "access", "open(s)","io(s)", "sync(s)", "close(s)", "total(s)",
+	      "tput(MiB/s)", "iter");
       fflush(stdout);
     }
 } /* display_rep_header() */
 
 /*
- * Shows the summary results of a single repetition of a read/write test.
+ * Shows the summary results of a single repetition of a test. With a
+ * stonewall, the throughput up to the stonewall is shown below the full one,
+ * which includes the wear-out. For tests with latency samples (mixed and open
+ * loop tests), the rate and latency of each operation are also shown. For
+ * LOG_STRUCTURED writes, the time spent in the extent counter and the spread
+ * of the transfers over the tasks are shown. For update tests, whose row
+ * counts the useful bytes, the bytes moved by the read-modify-write windows
+ * are shown below it.
  */
 void
 display_test_results (access_t access, int r)
 {
-  iore_time_t summary[R_CLOSE_STOP + 1] = { 0 };
+  iore_time_t summary[NUM_TEST_TIMERS] = { 0 };
   iore_size_t data_moved = 0;
-  char *format = "%s %10.4f  %12.4f  %10.4f  %12.4f  %12.4f %5d\n";
+  iore_size_t op_moved[2] = { 0 };
+  iore_hist_t *hist = NULL;
+  char *format =
+    "%-6s %10.4f  %12.4f  %10.4f  %10.4f  %12.4f  %12.4f %5d\n";
+  char *sw_format = "  stonewall %10.4f s  %12.4f MiB/s  "
+    "transfers min %lld max %lld\n";
+  iore_time_t sw_time = 0;
+  iore_size_t sw_moved = 0;
+  iore_size_t sw_min = 0;
+  iore_size_t sw_max = 0;
+  char *op_format = "  %-5s %10lld ops  %10.1f IOPS  %12.4f MiB/s  "
+    "lat(us) mean %.1f p50 %.1f p99 %.1f max %.1f\n";
+  char *counter_format = "  counter   %10.4f s  %12.1f us/op  "
+    "transfers min %lld max %lld\n";
+  iore_time_t counter_times[2] = { 0 };
+  iore_size_t counter_total = 0;
+  iore_size_t counter_min = 0;
+  iore_size_t update_moved = 0;
+  iore_size_t counter_max = 0;
+  iore_time_t sync_time = 0;
+  iore_size_t sync_count = 0;
   MPI_Op op;
+  int first;
   int i;
 
   if (task->verbosity >= NORMAL)
     {
-      if (access == WRITE)
+      first = get_first_timer (access);
+
+      /* find the minimum time for each even numbered timer (start timers),
+	 and the maximum time for each odd numbered timer (stop timers) */
+      for (i = 0; i < NUM_TEST_TIMERS; i++)
+	{
+	  op = i % 2 == 0 ? MPI_MIN : MPI_MAX;
+	  MPI_TRYCATCH(MPI_Reduce (&task->timer[first + i][r], &summary[i], 1,
+				   MPI_DOUBLE, op, MASTER_RANK, task->comm),
+		       "Failed to summarize test results");
+	}
+
+      /* compute the total amount of data moved in the test */
+      MPI_TRYCATCH(MPI_Reduce (&task->data_moved[access][r], &data_moved,
+			       1, MPI_LONG_LONG_INT, MPI_SUM, MASTER_RANK,
+			       task->comm),
+		   "Failed to summarize test results");
+
+      if (task->rank == MASTER_RANK)
 	{
-	  /* find the minimum time for each even numbered timer (start timers),
-	     and the maximum time for each odd numbered timer (stop timers) */
-	  for (i = W_OPEN_START; i <= W_CLOSE_STOP; i++)
+	  fprintf (stdout, format, get_access_name (access),
+		   summary[T_OPEN_STOP] - summary[T_OPEN_START],
+		   summary[T_STOP] - summary[T_START],
+		   summary[T_SYNC_STOP] - summary[T_SYNC_START],
+		   summary[T_CLOSE_STOP] - summary[T_CLOSE_START],
+		   summary[T_CLOSE_STOP] - summary[T_OPEN_START],
+		   (((double)(data_moved / MEBIBYTE)) /
+		    (summary[T_CLOSE_STOP] - summary[T_OPEN_START])),
+		   r);
+	  fflush (stdout);
+	}
+
+      if (task->stonewall_time >= 0)
+	{
+	  MPI_TRYCATCH(MPI_Reduce (&task->stonewall_time, &sw_time, 1,
+				   MPI_DOUBLE, MPI_MAX, MASTER_RANK,
+				   task->comm),
+		       "Failed to summarize stonewall results");
+	  MPI_TRYCATCH(MPI_Reduce (&task->stonewall_moved, &sw_moved, 1,
+				   MPI_LONG_LONG_INT, MPI_SUM, MASTER_RANK,
+				   task->comm),
+		       "Failed to summarize stonewall results");
+	  MPI_TRYCATCH(MPI_Reduce (&task->stonewall_count, &sw_min, 1,
+				   MPI_LONG_LONG_INT, MPI_MIN, MASTER_RANK,
+				   task->comm),
+		       "Failed to summarize stonewall results");
+	  MPI_TRYCATCH(MPI_Reduce (&task->stonewall_count, &sw_max, 1,
+				   MPI_LONG_LONG_INT, MPI_MAX, MASTER_RANK,
+				   task->comm),
+		       "Failed to summarize stonewall results");
+
+	  if (task->rank == MASTER_RANK)
 	    {
-	      op = i % 2 == 0 ? MPI_MIN : MPI_MAX;
-	      MPI_TRYCATCH(MPI_Reduce (&task->timer[i][r], &summary[i], 1,
-				       MPI_DOUBLE, op, MASTER_RANK,
-				       task->comm),
-			   "Failed to summarize write test results");
+	      fprintf (stdout, sw_format, sw_time,
+		       ((double) sw_moved / MEBIBYTE) / sw_time, sw_min,
+		       sw_max);
+	      fflush (stdout);
 	    }
+	}
 
-	  /* compute the total amount of data moved in the test */
-	  MPI_TRYCATCH(MPI_Reduce (&task->data_moved[WRITE][r], &data_moved,
-				   1, MPI_LONG_LONG_INT, MPI_SUM, MASTER_RANK,
+      if (access == UPDATE)
+	{
+	  MPI_TRYCATCH(MPI_Reduce (&task->update_moved, &update_moved, 1,
+				   MPI_LONG_LONG_INT, MPI_SUM, MASTER_RANK,
 				   task->comm),
-		       "Failed to summarize write test results");
+		       "Failed to summarize update results");
 
 	  if (task->rank == MASTER_RANK)
 	    {
-	      fprintf (stdout, format, "write",
-		       summary[W_OPEN_STOP] - summary[W_OPEN_START],
-		       summary[W_STOP] - summary[W_START],
-		       summary[W_CLOSE_STOP] - summary[W_CLOSE_START],
-		       summary[W_CLOSE_STOP] - summary[W_OPEN_START],
-		       (((double)(data_moved / MEBIBYTE)) /
-			(summary[W_CLOSE_STOP] - summary[W_OPEN_START])),
-		       r);
+	      fprintf (stdout, "  useful %12.4f MiB/s  moved %12.4f MiB/s  "
+		       "amplification %.2f\n",
+		       ((double) data_moved / MEBIBYTE) /
+		       (summary[T_STOP] - summary[T_START]),
+		       ((double) update_moved / MEBIBYTE) /
+		       (summary[T_STOP] - summary[T_START]),
+		       (double) update_moved / data_moved);
 	      fflush (stdout);
 	    }
 	}
-      else /* READ */
+
+      /* flushes issued while writing, which the io time includes */
+      if (access == WRITE || access == MIXED || access == UPDATE)
 	{
-	  /* find the minimum time for each even numbered timer (start timers),
-	     and the maximum time for each odd numbered timer (stop timers) */
-	  for (i = R_OPEN_START; i <= R_CLOSE_STOP; i++)
+	  MPI_TRYCATCH(MPI_Reduce (&task->sync_time, &sync_time, 1,
+				   MPI_DOUBLE, MPI_MAX, MASTER_RANK,
+				   task->comm),
+		       "Failed to summarize sync results");
+	  MPI_TRYCATCH(MPI_Reduce (&task->sync_count, &sync_count, 1,
+				   MPI_LONG_LONG_INT, MPI_SUM, MASTER_RANK,
+				   task->comm),
+		       "Failed to summarize sync results");
+
+	  if (task->rank == MASTER_RANK && sync_count > 0)
 	    {
-	      op = i % 2 == 0 ? MPI_MIN : MPI_MAX;
-	      MPI_TRYCATCH(MPI_Reduce (&task->timer[i][r], &summary[i], 1,
-				       MPI_DOUBLE, op, MASTER_RANK,
-				       task->comm),
-			   "Failed to summarize read test results");
+	      fprintf (stdout, "  interval  %10.4f s  %12lld syncs\n",
+		       sync_time, sync_count);
+	      fflush (stdout);
 	    }
+	}
 
-	  /* compute the total amount of data moved in the test */
-	  MPI_TRYCATCH(MPI_Reduce (&task->data_moved[READ][r], &data_moved,
-				   1, MPI_LONG_LONG_INT, MPI_SUM, MASTER_RANK,
+      if (access == WRITE && task->counter_time >= 0)
+	{
+	  MPI_TRYCATCH(MPI_Reduce (&task->counter_time, &counter_times[0], 1,
+				   MPI_DOUBLE, MPI_MAX, MASTER_RANK,
+				   task->comm),
+		       "Failed to summarize counter results");
+	  MPI_TRYCATCH(MPI_Reduce (&task->counter_time, &counter_times[1], 1,
+				   MPI_DOUBLE, MPI_SUM, MASTER_RANK,
+				   task->comm),
+		       "Failed to summarize counter results");
+	  MPI_TRYCATCH(MPI_Reduce (&task->counter_count, &counter_total, 1,
+				   MPI_LONG_LONG_INT, MPI_SUM, MASTER_RANK,
+				   task->comm),
+		       "Failed to summarize counter results");
+	  MPI_TRYCATCH(MPI_Reduce (&task->counter_count, &counter_min, 1,
+				   MPI_LONG_LONG_INT, MPI_MIN, MASTER_RANK,
+				   task->comm),
+		       "Failed to summarize counter results");
+	  MPI_TRYCATCH(MPI_Reduce (&task->counter_count, &counter_max, 1,
+				   MPI_LONG_LONG_INT, MPI_MAX, MASTER_RANK,
 				   task->comm),
-		       "Failed to summarize read test results");
+		       "Failed to summarize counter results");
 
+	  /* the slowest task's time, and the mean time of an allocation */
 	  if (task->rank == MASTER_RANK)
 	    {
-	      fprintf (stdout, format, "read",
-		       summary[R_OPEN_STOP] - summary[R_OPEN_START],
-		       summary[R_STOP] - summary[R_START],
-		       summary[R_CLOSE_STOP] - summary[R_CLOSE_START],
-		       summary[R_CLOSE_STOP] - summary[R_OPEN_START],
-		       (((double)(data_moved / MEBIBYTE)) /
-			(summary[R_CLOSE_STOP] - summary[R_OPEN_START])),
-		       r);
+	      fprintf (stdout, counter_format, counter_times[0],
+		       (counter_times[1] / counter_total) * 1e6, counter_min,
+		       counter_max);
 	      fflush (stdout);
 	    }
 	}
+
+      MPI_TRYCATCH(MPI_Reduce (task->samples[access].moved, op_moved, 2,
+			       MPI_LONG_LONG_INT, MPI_SUM, MASTER_RANK,
+			       task->comm),
+		   "Failed to summarize test results");
+
+      hist = (iore_hist_t *) malloc (sizeof (iore_hist_t));
+      if (hist == NULL)
+	FATAL("Failed to allocate memory for the latency histogram");
+
+      for (i = READ; i <= WRITE; i++)
+	{
+	  if (access != MIXED && access != REPLAY && access != (access_t) i)
+	    continue;
+
+	  reduce_hist (&task->samples[access].latency[i], hist, task->comm);
+
+	  if (task->rank == MASTER_RANK && hist->total > 0)
+	    {
+	      fprintf (stdout, op_format, get_access_name (i), hist->total,
+		       hist->total / (summary[T_STOP] - summary[T_START]),
+		       ((double) op_moved[i] / MEBIBYTE) /
+		       (summary[T_STOP] - summary[T_START]),
+		       hist_mean (hist) * 1e6,
+		       hist_percentile (hist, 50) * 1e6,
+		       hist_percentile (hist, 99) * 1e6, hist->max * 1e6);
+	      fflush (stdout);
+	    }
+	}
+
+      free (hist);
     }
 } /* display_test_results (access_t, int) */
 
+/*
+ * Shows the time to solution of a checkpoint/restart workload, with the
+ * compute and I/O times of the slowest tasks and the fraction of the time to
+ * solution spent in I/O.
+ */
+void
+display_checkpoint_results (iore_time_t solution_time,
+			    iore_time_t compute_time, iore_time_t io_time,
+			    int num_checkpoints)
+{
+  iore_time_t summary[3] = { 0 };
+  iore_time_t times[3];
+
+  if (task->verbosity < NORMAL)
+    return;
+
+  times[0] = solution_time;
+  times[1] = compute_time;
+  times[2] = io_time;
+  MPI_TRYCATCH(MPI_Reduce (times, summary, 3, MPI_DOUBLE, MPI_MAX,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize checkpoint results");
+
+  if (task->rank == MASTER_RANK)
+    {
+      fprintf (stdout, "  solution %10.4f s  compute %10.4f s  "
+	       "io %10.4f s (%.1f%%)  checkpoints %d\n", summary[0],
+	       summary[1], summary[2], 100.0 * summary[2] / summary[0],
+	       num_checkpoints);
+      fflush (stdout);
+    }
+} /* display_checkpoint_results (iore_time_t, iore_time_t, iore_time_t, int) */
+
+/*
+ * Shows the time spent preparing the files of a write test, and the write
+ * throughput with and without it, so runs with preallocated, sparse and
+ * growing files can be compared.
+ */
+void
+display_alloc_results (int r, preallocation_t preallocation)
+{
+  iore_time_t starts[2], stops[2];
+  iore_time_t first_start[2] = { 0 };
+  iore_time_t last_stop[2] = { 0 };
+  iore_size_t data_moved = 0;
+  iore_time_t alloc_time, write_time;
+
+  if (task->verbosity < NORMAL)
+    return;
+
+  starts[0] = task->timer[A_START][r];
+  starts[1] = task->timer[W_START][r];
+  stops[0] = task->timer[A_STOP][r];
+  stops[1] = task->timer[W_STOP][r];
+  MPI_TRYCATCH(MPI_Reduce (starts, first_start, 2, MPI_DOUBLE, MPI_MIN,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize preallocation results");
+  MPI_TRYCATCH(MPI_Reduce (stops, last_stop, 2, MPI_DOUBLE, MPI_MAX,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize preallocation results");
+  MPI_TRYCATCH(MPI_Reduce (&task->data_moved[WRITE][r], &data_moved, 1,
+			   MPI_LONG_LONG_INT, MPI_SUM, MASTER_RANK,
+			   task->comm),
+	       "Failed to summarize preallocation results");
+
+  if (task->rank == MASTER_RANK)
+    {
+      alloc_time = last_stop[0] - first_start[0];
+      write_time = last_stop[1] - first_start[1];
+      fprintf (stdout, "  %-9s %10.4f s  write %12.4f MiB/s  "
+	       "with %s %12.4f MiB/s\n",
+	       (preallocation == FALLOCATE) ? "fallocate" : "sparse",
+	       alloc_time, ((double) data_moved / MEBIBYTE) / write_time,
+	       (preallocation == FALLOCATE) ? "fallocate" : "truncate",
+	       ((double) data_moved / MEBIBYTE) / (alloc_time + write_time));
+      fflush (stdout);
+    }
+} /* display_alloc_results (int, preallocation_t) */
+
+/*
+ * Shows the time taken to evict the test files from the page cache before a
+ * read test, and the fraction of them still resident afterwards: the mean
+ * over all tasks and the largest of a task. Reads of resident data are
+ * served by the page cache, not by the file system.
+ */
+void
+display_evict_results (int r, iore_time_t time, iore_size_t resident,
+		       iore_size_t file_size)
+{
+  iore_time_t max_time = 0;
+  iore_size_t counts[2];
+  iore_size_t sums[2] = { 0 };
+  double fraction, max_fraction = 0;
+
+  if (task->verbosity < NORMAL)
+    return;
+
+  counts[0] = resident;
+  counts[1] = file_size;
+  fraction = (file_size > 0) ? (double) resident / file_size : 0;
+  MPI_TRYCATCH(MPI_Reduce (&time, &max_time, 1, MPI_DOUBLE, MPI_MAX,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize eviction results");
+  MPI_TRYCATCH(MPI_Reduce (counts, sums, 2, MPI_LONG_LONG_INT, MPI_SUM,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize eviction results");
+  MPI_TRYCATCH(MPI_Reduce (&fraction, &max_fraction, 1, MPI_DOUBLE, MPI_MAX,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize eviction results");
+
+  if (task->rank == MASTER_RANK)
+    {
+      fprintf (stdout, "  evict     %10.4f s  resident mean %5.1f%%  "
+	       "max %5.1f%% %5d\n", max_time,
+	       (sums[1] > 0) ? ((double) sums[0] / sums[1]) * 100 : 0,
+	       max_fraction * 100, r);
+      fflush (stdout);
+    }
+} /* display_evict_results (int, iore_time_t, iore_size_t, iore_size_t) */
+
+/*
+ * Shows the rate of the hole punching phase over all tasks.
+ */
+void
+display_punch_results (int r, iore_size_t num_holes, iore_size_t data_freed)
+{
+  iore_time_t first_start = 0;
+  iore_time_t last_stop = 0;
+  iore_size_t counts[2];
+  iore_size_t sums[2] = { 0 };
+  iore_time_t time;
+
+  if (task->verbosity < NORMAL)
+    return;
+
+  counts[0] = num_holes;
+  counts[1] = data_freed;
+  MPI_TRYCATCH(MPI_Reduce (&task->timer[H_START][r], &first_start, 1,
+			   MPI_DOUBLE, MPI_MIN, MASTER_RANK, task->comm),
+	       "Failed to summarize hole punching results");
+  MPI_TRYCATCH(MPI_Reduce (&task->timer[H_STOP][r], &last_stop, 1, MPI_DOUBLE,
+			   MPI_MAX, MASTER_RANK, task->comm),
+	       "Failed to summarize hole punching results");
+  MPI_TRYCATCH(MPI_Reduce (counts, sums, 2, MPI_LONG_LONG_INT, MPI_SUM,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize hole punching results");
+
+  if (task->rank == MASTER_RANK)
+    {
+      time = last_stop - first_start;
+      fprintf (stdout, "punch  %10lld holes %10.4f s  %11.1f holes/s  "
+	       "%12.4f MiB/s %5d\n", sums[0], time, sums[0] / time,
+	       ((double) sums[1] / MEBIBYTE) / time, r);
+      fflush (stdout);
+    }
+} /* display_punch_results (int, iore_size_t, iore_size_t) */
+
+/*
+ * Compares the time of a delta checkpoint, from the first open to the last
+ * close of its write test, with that of the full write of the first
+ * repetition.
+ */
+void
+display_delta_results (int r, double dirty_fraction)
+{
+  iore_time_t starts[2], stops[2];
+  iore_time_t first_start[2] = { 0 };
+  iore_time_t last_stop[2] = { 0 };
+  iore_time_t full_time, delta_time;
+
+  if (task->verbosity < NORMAL)
+    return;
+
+  starts[0] = task->timer[W_OPEN_START][0];
+  starts[1] = task->timer[W_OPEN_START][r];
+  stops[0] = task->timer[W_CLOSE_STOP][0];
+  stops[1] = task->timer[W_CLOSE_STOP][r];
+  MPI_TRYCATCH(MPI_Reduce (starts, first_start, 2, MPI_DOUBLE, MPI_MIN,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize delta results");
+  MPI_TRYCATCH(MPI_Reduce (stops, last_stop, 2, MPI_DOUBLE, MPI_MAX,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize delta results");
+
+  if (task->rank == MASTER_RANK)
+    {
+      full_time = last_stop[0] - first_start[0];
+      delta_time = last_stop[1] - first_start[1];
+      fprintf (stdout, "  delta %5.1f%% dirty  time %10.4f s  "
+	       "full write %10.4f s  speedup %.2f\n", 100.0 * dirty_fraction,
+	       delta_time, full_time, full_time / delta_time);
+      fflush (stdout);
+    }
+} /* display_delta_results (int, double) */
+
+/*
+ * Shows the sample rate, throughput and sample latencies of an epoch of a
+ * data loader, over all tasks.
+ */
+void
+display_epoch_results (int epoch, iore_time_t time, iore_size_t num_samples,
+		       iore_size_t data_moved, iore_hist_t *latency)
+{
+  iore_time_t max_time = 0;
+  iore_size_t sums[2] = { 0 };
+  iore_size_t counts[2];
+  iore_hist_t *hist;
+
+  if (task->verbosity < NORMAL)
+    return;
+
+  counts[0] = num_samples;
+  counts[1] = data_moved;
+  MPI_TRYCATCH(MPI_Reduce (&time, &max_time, 1, MPI_DOUBLE, MPI_MAX,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize epoch results");
+  MPI_TRYCATCH(MPI_Reduce (counts, sums, 2, MPI_LONG_LONG_INT, MPI_SUM,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize epoch results");
+
+  hist = (iore_hist_t *) malloc (sizeof (iore_hist_t));
+  if (hist == NULL)
+    FATAL("Failed to allocate memory for the latency histogram");
+
+  reduce_hist (latency, hist, task->comm);
+
+  if (task->rank == MASTER_RANK)
+    {
+      fprintf (stdout, "  epoch %-4d %10lld samples  %10.1f samples/s  "
+	       "%12.4f MiB/s  lat(us) mean %.1f p50 %.1f p99 %.1f max %.1f\n",
+	       epoch, sums[0], sums[0] / max_time,
+	       ((double) sums[1] / MEBIBYTE) / max_time,
+	       hist_mean (hist) * 1e6, hist_percentile (hist, 50) * 1e6,
+	       hist_percentile (hist, 99) * 1e6, hist->max * 1e6);
+      fflush (stdout);
+    }
+
+  free (hist);
+} /* display_epoch_results (int, iore_time_t, iore_size_t, iore_size_t, ...) */
+
+/*
+ * Shows the header of the results of a log append sweep.
+ */
+void
+display_append_header ()
+{
+  if (task->verbosity >= NORMAL && task->rank == MASTER_RANK)
+    {
+      fprintf (stdout, "\nLog append sweep:\n");
+      fprintf (stdout, "appenders  files     records   tput(MiB/s)    "
+	       "appends/s   p50(us)   p99(us)   max(us)\n");
+      fflush (stdout);
+    }
+} /* display_append_header () */
+
+/*
+ * Shows the throughput and append latencies of a step of a log append sweep,
+ * over the appending tasks; other tasks contribute no time or data.
+ */
+void
+display_append_results (int appenders, int num_files, iore_time_t time,
+			iore_size_t data_moved, iore_hist_t *latency)
+{
+  iore_time_t max_time = 0;
+  iore_size_t total_moved = 0;
+  iore_hist_t *hist;
+
+  if (task->verbosity < NORMAL)
+    return;
+
+  MPI_TRYCATCH(MPI_Reduce (&time, &max_time, 1, MPI_DOUBLE, MPI_MAX,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize append results");
+  MPI_TRYCATCH(MPI_Reduce (&data_moved, &total_moved, 1, MPI_LONG_LONG_INT,
+			   MPI_SUM, MASTER_RANK, task->comm),
+	       "Failed to summarize append results");
+
+  hist = (iore_hist_t *) malloc (sizeof (iore_hist_t));
+  if (hist == NULL)
+    FATAL("Failed to allocate memory for the latency histogram");
+
+  reduce_hist (latency, hist, task->comm);
+
+  if (task->rank == MASTER_RANK)
+    {
+      fprintf (stdout, "%9d %6d %11lld  %12.4f %12.1f %9.1f %9.1f %9.1f\n",
+	       appenders, num_files, hist->total,
+	       ((double) total_moved / MEBIBYTE) / max_time,
+	       hist->total / max_time, hist_percentile (hist, 50) * 1e6,
+	       hist_percentile (hist, 99) * 1e6, hist->max * 1e6);
+      fflush (stdout);
+    }
+
+  free (hist);
+} /* display_append_results (int, int, iore_time_t, iore_size_t, ...) */
+
+/*
+ * Shows the header of the results of a many-small-files workload.
+ */
+void
+display_files_header ()
+{
+  if (task->verbosity >= NORMAL && task->rank == MASTER_RANK)
+    {
+      fprintf (stdout, "\naccess        files     time(s)      files/s   "
+	       "tput(MiB/s)   p50(us)   p99(us)   max(us)  iter\n");
+      fflush (stdout);
+    }
+} /* display_files_header () */
+
+/*
+ * Shows the file rate, throughput and per-file latencies, from the open to
+ * the close of each file, of a phase of a many-small-files workload, over all
+ * tasks.
+ */
+void
+display_files_results (access_t access, int r, iore_time_t time,
+		       iore_size_t num_files, iore_size_t data_moved,
+		       iore_hist_t *latency)
+{
+  iore_time_t max_time = 0;
+  iore_size_t sums[2] = { 0 };
+  iore_size_t counts[2];
+  iore_hist_t *hist;
+
+  if (task->verbosity < NORMAL)
+    return;
+
+  counts[0] = num_files;
+  counts[1] = data_moved;
+  MPI_TRYCATCH(MPI_Reduce (&time, &max_time, 1, MPI_DOUBLE, MPI_MAX,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize file results");
+  MPI_TRYCATCH(MPI_Reduce (counts, sums, 2, MPI_LONG_LONG_INT, MPI_SUM,
+			   MASTER_RANK, task->comm),
+	       "Failed to summarize file results");
+
+  hist = (iore_hist_t *) malloc (sizeof (iore_hist_t));
+  if (hist == NULL)
+    FATAL("Failed to allocate memory for the latency histogram");
+
+  reduce_hist (latency, hist, task->comm);
+
+  if (task->rank == MASTER_RANK)
+    {
+      fprintf (stdout, "%-6s %12lld  %10.4f  %11.1f  %12.4f %9.1f %9.1f "
+	       "%9.1f %5d\n", get_access_name (access), sums[0], max_time,
+	       sums[0] / max_time, ((double) sums[1] / MEBIBYTE) / max_time,
+	       hist_percentile (hist, 50) * 1e6,
+	       hist_percentile (hist, 99) * 1e6, hist->max * 1e6, r);
+      fflush (stdout);
+    }
+
+  free (hist);
+} /* display_files_results (access_t, int, iore_time_t, iore_size_t, ...) */
+
+/*
+ * Shows the header of the results of a visibility workload.
+ */
+void
+display_visibility_header ()
+{
+  if (task->verbosity >= NORMAL && task->rank == MASTER_RANK)
+    {
+      fprintf (stdout, "\nhandoff    visible  timeouts  mean(us)   p50(us)   "
+	       "p99(us)   max(us)  iter\n");
+      fflush (stdout);
+    }
+} /* display_visibility_header () */
+
+/*
+ * Shows the distribution of the delays until the readers saw the records of a
+ * handoff mode, over all readers, and the number of reads that timed out.
+ */
+void
+display_visibility_results (handoff_t handoff, int r, iore_size_t timeouts,
+			    iore_hist_t *delays)
+{
+  iore_size_t total_timeouts = 0;
+  iore_hist_t *hist;
+  char *names[NUM_HANDOFFS] = { "write", "fsync", "close" };
+
+  if (task->verbosity < NORMAL)
+    return;
+
+  MPI_TRYCATCH(MPI_Reduce (&timeouts, &total_timeouts, 1, MPI_LONG_LONG_INT,
+			   MPI_SUM, MASTER_RANK, task->comm),
+	       "Failed to summarize visibility results");
+
+  hist = (iore_hist_t *) malloc (sizeof (iore_hist_t));
+  if (hist == NULL)
+    FATAL("Failed to allocate memory for the latency histogram");
+
+  reduce_hist (delays, hist, task->comm);
+
+  if (task->rank == MASTER_RANK)
+    {
+      fprintf (stdout, "%-7s %10lld %9lld %9.1f %9.1f %9.1f %9.1f %5d\n",
+	       names[handoff], hist->total, total_timeouts,
+	       hist_mean (hist) * 1e6, hist_percentile (hist, 50) * 1e6,
+	       hist_percentile (hist, 99) * 1e6, hist->max * 1e6, r);
+      fflush (stdout);
+    }
+
+  free (hist);
+} /* display_visibility_results (handoff_t, int, iore_size_t, ...) */
+
+/*
+ * Shows the header of the results of a metadata workload.
+ */
+void
+display_md_header ()
+{
+  if (task->verbosity >= NORMAL && task->rank == MASTER_RANK)
+    {
+      fprintf (stdout, "\nphase            ops     time(s)        ops/s  "
+	       "iter\n");
+      fflush (stdout);
+    }
+} /* display_md_header () */
+
+/*
+ * Shows the rate of each phase of a metadata workload: the operations of all
+ * tasks over the time from the first start to the last stop of the phase.
+ */
+void
+display_md_results (int r, iore_time_t *starts, iore_time_t *stops,
+		    iore_size_t *counts)
+{
+  iore_time_t first_start[NUM_MD_PHASES] = { 0 };
+  iore_time_t last_stop[NUM_MD_PHASES] = { 0 };
+  iore_size_t total[NUM_MD_PHASES] = { 0 };
+  iore_time_t time;
+  int p;
+
+  if (task->verbosity < NORMAL)
+    return;
+
+  MPI_TRYCATCH(MPI_Reduce (starts, first_start, NUM_MD_PHASES, MPI_DOUBLE,
+			   MPI_MIN, MASTER_RANK, task->comm),
+	       "Failed to summarize metadata results");
+  MPI_TRYCATCH(MPI_Reduce (stops, last_stop, NUM_MD_PHASES, MPI_DOUBLE,
+			   MPI_MAX, MASTER_RANK, task->comm),
+	       "Failed to summarize metadata results");
+  MPI_TRYCATCH(MPI_Reduce (counts, total, NUM_MD_PHASES, MPI_LONG_LONG_INT,
+			   MPI_SUM, MASTER_RANK, task->comm),
+	       "Failed to summarize metadata results");
+
+  if (task->rank == MASTER_RANK)
+    {
+      for (p = 0; p < NUM_MD_PHASES; p++)
+	{
+	  time = last_stop[p] - first_start[p];
+	  fprintf (stdout, "%-8s %11lld  %10.4f  %11.1f %5d\n",
+		   get_md_phase_name (p), total[p], time, total[p] / time, r);
+	}
+      fflush (stdout);
+    }
+} /* display_md_results (int, iore_time_t *, iore_time_t *, iore_size_t *) */
+
+/*
+ * Summarize the throughput and latency of a test over all tasks. Throughput is
+ * known by all tasks, and latencies by the master rank only.
+ */
+void
+summarize_test (access_t access, int r, iore_point_t *point)
+{
+  iore_time_t start, stop;
+  iore_size_t data_moved = 0;
+  iore_hist_t *hist;
+  iore_hist_t *merged;
+  iore_size_t counts[3];
+  iore_size_t sums[3];
+  int first = get_first_timer (access);
+
+  MPI_TRYCATCH(MPI_Allreduce (&task->timer[first + T_START][r], &start, 1,
+			      MPI_DOUBLE, MPI_MIN, task->comm),
+	       "Failed to summarize test results");
+  MPI_TRYCATCH(MPI_Allreduce (&task->timer[first + T_STOP][r], &stop, 1,
+			      MPI_DOUBLE, MPI_MAX, task->comm),
+	       "Failed to summarize test results");
+  MPI_TRYCATCH(MPI_Allreduce (&task->data_moved[access][r], &data_moved, 1,
+			      MPI_LONG_LONG_INT, MPI_SUM, task->comm),
+	       "Failed to summarize test results");
+
+  hist = (iore_hist_t *) malloc (sizeof (iore_hist_t));
+  merged = (iore_hist_t *) malloc (sizeof (iore_hist_t));
+  if (hist == NULL || merged == NULL)
+    FATAL("Failed to allocate memory for the latency histogram");
+
+  /* reads and writes of mixed tests are summarized together */
+  reset_hist (hist);
+  merge_hist (&task->samples[access].latency[READ], hist);
+  merge_hist (&task->samples[access].latency[WRITE], hist);
+  reduce_hist (hist, merged, task->comm);
+
+  point->bandwidth = ((double) data_moved / MEBIBYTE) / (stop - start);
+  point->iops = merged->total / (stop - start);
+  point->p50 = hist_percentile (merged, 50);
+  point->p99 = hist_percentile (merged, 99);
+
+  /* transfers straddling the boundaries of blocks and stripes */
+  counts[0] = task->samples[access].transfers;
+  counts[1] = task->samples[access].straddles[0];
+  counts[2] = task->samples[access].straddles[1];
+  MPI_TRYCATCH(MPI_Allreduce (counts, sums, 3, MPI_LONG_LONG_INT, MPI_SUM,
+			      task->comm),
+	       "Failed to summarize test results");
+  point->straddles[0] = (sums[0] > 0) ? (double) sums[1] / sums[0] : 0;
+  point->straddles[1] = (sums[0] > 0) ? (double) sums[2] / sums[0] : 0;
+
+  free (hist);
+  free (merged);
+} /* summarize_test (access_t, int, iore_point_t *) */
+
+/*
+ * Shows the throughput and latency of each test at each queue depth of a
+ * sweep. Points hold the results of the read, write and mixed tests, in this
+ * order, for each depth; tests skipped by the deadline at a depth are not
+ * shown.
+ */
+void
+display_sweep_results (iore_point_t *points, int num_depths,
+		       iore_params_t *params)
+{
+  access_t order[3] = { WRITE, READ, MIXED }; /* as tests run */
+  int enabled[3];
+  int i, j;
+
+  if (task->verbosity < NORMAL || task->rank != MASTER_RANK)
+    return;
+
+  enabled[READ] = params->read_test;
+  enabled[WRITE] = params->write_test;
+  enabled[MIXED] = params->mixed_test;
+
+  fprintf (stdout, "\nQueue depth sweep:\n");
+  fprintf (stdout, "access   depth   tput(MiB/s)          IOPS     p50(us)"
+	   "     p99(us)\n");
+  for (j = 0; j < 3; j++)
+    if (enabled[order[j]])
+      for (i = 0; i < num_depths; i++)
+	if (points[(3 * i) + order[j]].ran)
+	  display_sweep_point (order[j], &points[(3 * i) + order[j]]);
+  fflush (stdout);
+} /* display_sweep_results (iore_point_t *, int, iore_params_t *) */
+
+/*
+ * Shows the throughput of each test at each shift of a misalignment sweep,
+ * with the fraction of its transfers straddling the boundaries of file system
+ * blocks and stripes, i.e., sharing a block or stripe with the neighbouring
+ * transfers, whose locks tasks of a shared file contend for. Points are laid
+ * out as in a queue depth sweep.
+ */
+void
+display_misalignment_results (iore_point_t *points, int num_shifts,
+			      iore_params_t *params)
+{
+  access_t order[3] = { WRITE, READ, MIXED }; /* as tests run */
+  int enabled[3];
+  iore_point_t *point;
+  int i, j;
+
+  if (task->verbosity < NORMAL || task->rank != MASTER_RANK)
+    return;
+
+  enabled[READ] = params->read_test;
+  enabled[WRITE] = params->write_test;
+  enabled[MIXED] = params->mixed_test;
+
+  fprintf (stdout, "\nMisalignment sweep:\n");
+  fprintf (stdout, "access        shift   tput(MiB/s)          IOPS   "
+	   "block(%%)  stripe(%%)\n");
+  for (j = 0; j < 3; j++)
+    if (enabled[order[j]])
+      for (i = 0; i < num_shifts; i++)
+	{
+	  point = &points[(3 * i) + order[j]];
+	  if (!point->ran)
+	    continue;
+	  fprintf (stdout, "%-6s %12lld  %12.4f  %12.1f  %9.1f  %9.1f\n",
+		   get_access_name (order[j]), point->misalignment,
+		   point->bandwidth, point->iops, point->straddles[0] * 100,
+		   point->straddles[1] * 100);
+	}
+  fflush (stdout);
+} /* display_misalignment_results (iore_point_t *, int, iore_params_t *) */
+
 /*
  * Shows timing results for each operation and task.
  *
@@ -406,22 +1374,11 @@ display_test_results (access_t access, int r)
 void
 display_per_task_results (access_t access, int r)
 {
-  char access_desc[MAX_STR_LEN];
   char timer_desc[MAX_STR_LEN];
   int i, first, last;
   
-  if (access == WRITE)
-    {
-      strcpy (access_desc, "write");
-      first = W_OPEN_START;
-      last = W_CLOSE_STOP;
-    }
-  else /* READ */
-    {
-      strcpy (access_desc, "read");
-      first = R_OPEN_START;
-      last = R_CLOSE_STOP;
-    }
+  first = get_first_timer (access);
+  last = first + NUM_TEST_TIMERS - 1;
 
   for (i = first; i <= last; i++)
     {
@@ -439,6 +1396,12 @@ display_per_task_results (access_t access, int r)
 	case W_STOP:
 	  strcpy (timer_desc, "write stop");
 	  break;
+	case W_SYNC_START:
+	  strcpy (timer_desc, "write sync start");
+	  break;
+	case W_SYNC_STOP:
+	  strcpy (timer_desc, "write sync stop");
+	  break;
 	case W_CLOSE_START:
 	  strcpy (timer_desc, "write close start");
 	  break;
@@ -457,12 +1420,90 @@ display_per_task_results (access_t access, int r)
 	case R_STOP:
 	  strcpy (timer_desc, "read stop");
 	  break;
+	case R_SYNC_START:
+	  strcpy (timer_desc, "read sync start");
+	  break;
+	case R_SYNC_STOP:
+	  strcpy (timer_desc, "read sync stop");
+	  break;
 	case R_CLOSE_START:
 	  strcpy (timer_desc, "read close start");
 	  break;
 	case R_CLOSE_STOP:
 	  strcpy (timer_desc, "read close stop");
 	  break;
+	case M_OPEN_START:
+	  strcpy (timer_desc, "mixed open start");
+	  break;
+	case M_OPEN_STOP:
+	  strcpy (timer_desc, "mixed open stop");
+	  break;
+	case M_START:
+	  strcpy (timer_desc, "mixed start");
+	  break;
+	case M_STOP:
+	  strcpy (timer_desc, "mixed stop");
+	  break;
+	case M_SYNC_START:
+	  strcpy (timer_desc, "mixed sync start");
+	  break;
+	case M_SYNC_STOP:
+	  strcpy (timer_desc, "mixed sync stop");
+	  break;
+	case M_CLOSE_START:
+	  strcpy (timer_desc, "mixed close start");
+	  break;
+	case M_CLOSE_STOP:
+	  strcpy (timer_desc, "mixed close stop");
+	  break;
+	case P_OPEN_START:
+	  strcpy (timer_desc, "replay open start");
+	  break;
+	case P_OPEN_STOP:
+	  strcpy (timer_desc, "replay open stop");
+	  break;
+	case P_START:
+	  strcpy (timer_desc, "replay start");
+	  break;
+	case P_STOP:
+	  strcpy (timer_desc, "replay stop");
+	  break;
+	case P_SYNC_START:
+	  strcpy (timer_desc, "replay sync start");
+	  break;
+	case P_SYNC_STOP:
+	  strcpy (timer_desc, "replay sync stop");
+	  break;
+	case P_CLOSE_START:
+	  strcpy (timer_desc, "replay close start");
+	  break;
+	case P_CLOSE_STOP:
+	  strcpy (timer_desc, "replay close stop");
+	  break;
+	case U_OPEN_START:
+	  strcpy (timer_desc, "update open start");
+	  break;
+	case U_OPEN_STOP:
+	  strcpy (timer_desc, "update open stop");
+	  break;
+	case U_START:
+	  strcpy (timer_desc, "update start");
+	  break;
+	case U_STOP:
+	  strcpy (timer_desc, "update stop");
+	  break;
+	case U_SYNC_START:
+	  strcpy (timer_desc, "update sync start");
+	  break;
+	case U_SYNC_STOP:
+	  strcpy (timer_desc, "update sync stop");
+	  break;
+	case U_CLOSE_START:
+	  strcpy (timer_desc, "update close start");
+	  break;
+	case U_CLOSE_STOP:
+	  strcpy (timer_desc, "update close stop");
+	  break;
 	}
 
       fprintf (stdout, "Run %d: Iter=%d, Task=%d, Time=%f, %s\n",
@@ -470,3 +1511,133 @@ display_per_task_results (access_t access, int r)
       fflush (stdout);
     }
 } /* display_per_task_results (access_t, int) */
+
+/*
+ * Returns the name of an access pattern.
+ */
+static char *
+get_access_pattern_name (access_pattern_t access_pattern)
+{
+  switch (access_pattern)
+    {
+    case SEQUENTIAL:
+      return ("SEQUENTIAL");
+    case RANDOM:
+      return ("RANDOM");
+    case ZIPFIAN:
+      return ("ZIPFIAN");
+    case HOTSPOT:
+      return ("HOTSPOT");
+    case GAUSSIAN:
+      return ("GAUSSIAN");
+    case REVERSE:
+      return ("REVERSE");
+    default: /* STRIDED */
+      return ("STRIDED");
+    }
+} /* get_access_pattern_name (access_pattern_t) */
+
+/*
+ * Returns the name of a phase of the metadata workload.
+ */
+static char *
+get_md_phase_name (md_phase_t phase)
+{
+  switch (phase)
+    {
+    case MD_MKDIR:
+      return ("mkdir");
+    case MD_CREATE:
+      return ("create");
+    case MD_STAT:
+      return ("stat");
+    case MD_OPEN:
+      return ("open");
+    case MD_READDIR:
+      return ("readdir");
+    case MD_RENAME:
+      return ("rename");
+    case MD_UNLINK:
+      return ("unlink");
+    default: /* MD_RMDIR */
+      return ("rmdir");
+    }
+} /* get_md_phase_name (md_phase_t) */
+
+/*
+ * Returns the name of a durability mode, as given in the run parameters.
+ */
+static char *
+get_durability_name (durability_t durability)
+{
+  switch (durability)
+    {
+    case FSYNC:
+      return ("FSYNC");
+    case FSYNC_INTERVAL:
+      return ("FSYNC_INTERVAL");
+    case FDATASYNC:
+      return ("FDATASYNC");
+    case DSYNC_OPEN:
+      return ("O_DSYNC");
+    case SYNC_OPEN:
+      return ("O_SYNC");
+    case SYNC_FILE_RANGE:
+      return ("SYNC_FILE_RANGE");
+    default: /* NO_DURABILITY */
+      return ("NONE");
+    }
+} /* get_durability_name (durability_t) */
+
+/*
+ * Returns the name of an access type.
+ */
+static char *
+get_access_name (access_t access)
+{
+  switch (access)
+    {
+    case READ:
+      return ("read");
+    case WRITE:
+      return ("write");
+    case MIXED:
+      return ("mixed");
+    case UPDATE:
+      return ("update");
+    default: /* REPLAY */
+      return ("replay");
+    }
+} /* get_access_name (access_t) */
+
+/*
+ * Returns the first timer of a test.
+ */
+static int
+get_first_timer (access_t access)
+{
+  switch (access)
+    {
+    case READ:
+      return (R_OPEN_START);
+    case WRITE:
+      return (W_OPEN_START);
+    case MIXED:
+      return (M_OPEN_START);
+    case UPDATE:
+      return (U_OPEN_START);
+    default: /* REPLAY */
+      return (P_OPEN_START);
+    }
+} /* get_first_timer (access_t) */
+
+/*
+ * Shows a point of a queue depth sweep.
+ */
+static void
+display_sweep_point (access_t access, iore_point_t *point)
+{
+  fprintf (stdout, "%-6s %7d  %12.4f  %12.1f  %10.1f  %10.1f\n",
+	   get_access_name (access), point->queue_depth, point->bandwidth,
+	   point->iops, point->p50 * 1e6, point->p99 * 1e6);
+} /* display_sweep_point (access_t, iore_point_t *) */
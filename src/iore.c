@@ -1,5 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include <time.h>
 #include <unistd.h>
 #include <sys/stat.h>
@@ -10,9 +12,28 @@
 #include "iore_params.h"
 #include "iore_aio.h"
 #include "iore_task.h"
+#include "iore_offsets.h"
+#include "iore_rand.h"
+#include "iore_hist.h"
+#include "iore_trace.h"
+#include "iore_loader.h"
+#include "iore_sizes.h"
 #include "display.h"
 #include "util.h"
 
+/*****************************************************************************
+ * D E F I N I T I O N S
+ *****************************************************************************/
+
+#define SWEEP_MIN_GAIN 0.05 /* throughput gain to go on with a sweep */
+
+/* transfer in flight with the asynchronous interface of a backend */
+typedef struct iore_queue
+{
+  void *request; /* request handle returned by the backend */
+  iore_trace_record_t rec; /* transfer, from its submission or arrival time */
+} iore_queue_t;
+
 /*****************************************************************************
  * P R O T O T Y P E S                                                       
  *****************************************************************************/
@@ -26,23 +47,61 @@ static void setup_mpi_comm (iore_params_t *);
 /* experiment execution related functions */
 static void exec_run (iore_run_t *);
 static void exec_repetition (int, iore_time_t, iore_params_t *);
+static void exec_sweep (iore_time_t, iore_params_t *);
+static void exec_misalignment_sweep (iore_time_t, iore_params_t *);
 static void exec_write_test (int, iore_params_t *);
 static void exec_read_test (int, iore_params_t *);
+static void exec_mixed_test (int, iore_params_t *);
+static void exec_update_test (int, iore_params_t *);
+static void exec_punch_phase (int, iore_params_t *);
+static void prepare_test_files (void **, iore_offsets_t *, iore_params_t *);
+static void exec_replay_test (int, iore_params_t *);
+static void exec_checkpoint_workload (int, iore_time_t, iore_params_t *);
+static void compute (double, int);
+static void exec_loader_workload (int, iore_time_t, iore_params_t *);
+static void exec_append_workload (int, iore_time_t, iore_params_t *);
+static void exec_files_workload (int, iore_time_t, iore_params_t *);
+static void exec_visibility_workload (int, iore_params_t *);
+static void exec_md_workload (int, iore_params_t *);
+static iore_size_t exec_md_phase (md_phase_t, char **, iore_size_t,
+				  iore_params_t *);
 static void setup_run (iore_params_t *);
+static void validate_run (iore_params_t *);
 static void setup_perf_collectors (int);
-static void setup_io (access_t, iore_params_t *, iore_offset_t **, void **);
-static void cleanup_io (iore_offset_t **, void **);
+static void setup_io (access_t, int, iore_params_t *, iore_offsets_t **,
+		      void **);
+static void cleanup_io (iore_offsets_t **, void **);
 static void bind_aio_backend (char *);
 static void setup_data_signature ();
 static char *get_test_file_name (iore_params_t *, access_t, int);
 static char *create_rank_dir (char *, int);
 static void remove_file (iore_params_t *);
-static iore_size_t perform_io (void *, access_t, iore_offset_t *, iore_size_t *,
+static char *get_workload_file_name (iore_params_t *, iore_size_t, int);
+static void remove_workload_files (iore_params_t *, int);
+static void **open_test_files (int, iore_params_t *);
+static void close_test_files (void **, iore_params_t *);
+static void sync_test_files (void **, iore_params_t *);
+static void sync_test_file (void *, iore_params_t *);
+static void flush_test_files (void **, iore_params_t *);
+static void evict_test_files (iore_time_t *, iore_size_t *, iore_size_t *,
+			      iore_params_t *);
+static char *get_open_file_name (char *, int);
+static iore_size_t perform_io (void **, access_t, int, iore_offsets_t *,
+			       iore_size_t *, iore_params_t *);
+static iore_size_t complete_io (iore_queue_t *, iore_samples_t *,
 			       iore_params_t *);
+static iore_size_t check_io (iore_trace_record_t *, iore_samples_t *);
+static void place_update (iore_offset_t *, iore_size_t *, unsigned long long,
+			  iore_size_t, iore_params_t *);
+static iore_size_t update_io (void *, iore_size_t *, char *, iore_offset_t,
+			      iore_size_t, iore_size_t, iore_params_t *);
+static iore_size_t wear_out (iore_size_t, iore_size_t, iore_time_t);
+static iore_time_t get_arrival (iore_time_t, iore_size_t, double,
+				unsigned long long, iore_params_t *);
+static void wait_until (iore_time_t);
+static int deadline_reached (iore_time_t, iore_params_t *);
 static void delay_secs (int);
-static iore_offset_t *get_sequential_offsets (int, iore_params_t *);
-static iore_offset_t *get_random_offsets (int, iore_params_t *);
-static void *get_buffer (access_t, int);
+static void *get_buffer (access_t, int, int);
 static int get_pretend_rank (iore_params_t *, access_t);
 
 /*****************************************************************************
@@ -89,7 +148,7 @@ main (int argc, char **argv)
       experiment = new_experiment(argc, argv);
       task->verbosity = experiment->verbosity;
       /* TODO: validate experiments? */
-      sync_rand_gen(MPI_COMM_WORLD);
+      task->random_seed = sync_rand_gen(MPI_COMM_WORLD);
 
       display_splash();
       
@@ -148,9 +207,10 @@ handle_preemptive_args (int argc, char **argv)
 static void
 init_mpi (int argc, char **argv)
 {
-  int nprocs, rank;
+  int nprocs, rank, provided;
 
-  MPI_TRYCATCH(MPI_Init(&argc, &argv),
+  /* prefetch threads of the data loader may abort on I/O errors */
+  MPI_TRYCATCH(MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided),
 	       "Failed to initialize MPI communicator.");
   MPI_TRYCATCH(MPI_Comm_size(MPI_COMM_WORLD, &nprocs),
 	       "Failed to get the number of MPI tasks.");
@@ -159,6 +219,7 @@ init_mpi (int argc, char **argv)
 
   /* initialize task context */
   task = new_task(nprocs, rank, MPI_COMM_WORLD);
+  task->thread_level = provided;
 } /* init_mpi (int, char **) */
 
 /*
@@ -228,9 +289,42 @@ exec_run (iore_run_t *run)
       deadline = current_time() + params->run_time_limit;
       display_run_info(run->id, params);
 
-      /* loop over run replications */
-      for (i = 0; i < params->num_repetitions; i++)
-	exec_repetition(i, deadline, params);
+      /* log append sweeps and the small files, metadata and visibility
+	 workloads show their own tables */
+      if (params->workload == SMALL_FILES)
+	display_files_header();
+      else if (params->workload == METADATA)
+	display_md_header();
+      else if (params->workload == VISIBILITY)
+	display_visibility_header();
+      else if (params->workload != LOG_APPEND)
+	display_rep_header();
+
+      /* loop over run replications, or over queue depths or offset shifts
+	 in a sweep */
+      if (params->max_queue_depth > 0)
+	exec_sweep(deadline, params);
+      else if (params->misalignment_steps > 0)
+	exec_misalignment_sweep(deadline, params);
+      else
+	for (i = 0; i < params->num_repetitions; i++)
+	  exec_repetition(i, deadline, params);
+
+      /* delta checkpoints keep their file over all the repetitions, also
+	 when the deadline cuts them short; its removal is timed as that of
+	 the last repetition */
+      if (!params->keep_file && params->dirty_fraction < 1)
+	{
+	  i = params->num_repetitions - 1;
+	  task->timer[D_START][i] = current_time();
+	  remove_file (params);
+	  task->timer[D_STOP][i] = current_time();
+
+	  MPI_TRYCATCH(MPI_Barrier(task->comm), "Failed syncing tasks.");
+	}
+
+      if (task->capture != NULL)
+	close_capture (task->capture);
       
       /* TODO: continue... */
     }
@@ -245,27 +339,96 @@ exec_run (iore_run_t *run)
 static void
 exec_repetition (int r, iore_time_t deadline, iore_params_t *params)
 {
+  int a;
+
   /* uses a different data signature for each iteration */
   setup_data_signature();
-  
-  if (r == 0)
-    display_rep_header();
 
-  /* write performance test */
-  if (params->write_test &&
-      (params->run_time_limit == 0 || current_time() < deadline))
-    exec_write_test(r, params);
+  /* no transfers are limited by a stonewalled write yet */
+  task->wear_out_count = -1;
+  task->counter_time = -1;
+
+  for (a = 0; a < NUM_ACCESS; a++)
+    task->tests_run[a] = FALSE;
+
+  /* trace replay, instead of the performance tests */
+  if (params->workload == TRACE_REPLAY)
+    exec_replay_test(r, params);
+
+  /* checkpoint/restart kernel, built on the write and read tests */
+  if (params->workload == CHECKPOINT_RESTART)
+    exec_checkpoint_workload(r, deadline, params);
+
+  /* training data loader emulation */
+  if (params->workload == DATA_LOADER)
+    exec_loader_workload(r, deadline, params);
+
+  /* sweep of concurrent appenders to shared logs */
+  if (params->workload == LOG_APPEND)
+    exec_append_workload(r, deadline, params);
+
+  /* many small files of varying sizes */
+  if (params->workload == SMALL_FILES)
+    exec_files_workload(r, deadline, params);
+
+  /* metadata rates in a directory tree */
+  if (params->workload == METADATA)
+    exec_md_workload(r, params);
+
+  /* read-after-write visibility delays between tasks */
+  if (params->workload == VISIBILITY)
+    exec_visibility_workload(r, params);
+
+  /* write performance test; all tasks skip the tests once the deadline is
+     reached, and keep track of those run */
+  if (params->workload == STANDARD && params->write_test &&
+      !deadline_reached(deadline, params))
+    {
+      exec_write_test(r, params);
+      task->tests_run[WRITE] = TRUE;
+    }
 
   /* read performance test */
-  if (params->read_test &&
-      (params->run_time_limit == 0 || current_time() < deadline))
-    exec_read_test(r, params);
+  if (params->workload == STANDARD && params->read_test &&
+      !deadline_reached(deadline, params))
+    {
+      exec_read_test(r, params);
+      task->tests_run[READ] = TRUE;
+    }
+
+  /* mixed read/write performance test */
+  if (params->workload == STANDARD && params->mixed_test &&
+      !deadline_reached(deadline, params))
+    {
+      exec_mixed_test(r, params);
+      task->tests_run[MIXED] = TRUE;
+    }
+
+  /* read-modify-write update performance test */
+  if (params->workload == STANDARD && params->update_test &&
+      !deadline_reached(deadline, params))
+    {
+      exec_update_test(r, params);
+      task->tests_run[UPDATE] = TRUE;
+    }
+
+  /* deallocation of the written transfers */
+  if (params->workload == STANDARD && params->punch_holes &&
+      params->write_test && !deadline_reached(deadline, params))
+    exec_punch_phase(r, params);
 
-  /* finalizing iteration */
-  if (!params->keep_file)
+  /* finalizing iteration; delta checkpoints keep the file until the end of
+     the run, and metadata workloads remove their tree themselves */
+  if (!params->keep_file && params->workload != METADATA &&
+      params->dirty_fraction == 1)
     {
       task->timer[D_START][r] = current_time();
-      remove_file (params);
+      if (params->workload == TRACE_REPLAY ||
+	  params->workload == DATA_LOADER || params->workload == LOG_APPEND ||
+	  params->workload == SMALL_FILES || params->workload == VISIBILITY)
+	remove_workload_files (params, r);
+      else
+	remove_file (params);
       task->timer[D_STOP][r] = current_time();
       /* TODO: remove rank dirs */
 
@@ -275,6 +438,125 @@ exec_repetition (int r, iore_time_t deadline, iore_params_t *params)
     }
 } /* exec_repetition (int, iore_time_t deadline, iore_params_t *); */
 
+/*
+ * Execute a sweep of queue depths 1, 2, 4, ... up to max_queue_depth, with a
+ * single repetition at each depth. The sweep stops when no test gains at least
+ * SWEEP_MIN_GAIN in throughput over the previous depth, i.e., at the knee of
+ * the throughput curve.
+ */
+static void
+exec_sweep (iore_time_t deadline, iore_params_t *params)
+{
+  iore_point_t *points;
+  int enabled[3];
+  int num_depths = 0;
+  int depth, gain, a;
+
+  for (depth = 1; depth <= params->max_queue_depth; depth *= 2)
+    num_depths++;
+
+  points = (iore_point_t *) malloc (3 * num_depths * sizeof (iore_point_t));
+  if (points == NULL)
+    {
+      FATAL("Failed to allocate memory for the sweep results");
+      MPI_Abort(MPI_COMM_WORLD, -1);
+    }
+
+  enabled[READ] = params->read_test;
+  enabled[WRITE] = params->write_test;
+  enabled[MIXED] = params->mixed_test;
+
+  num_depths = 0;
+  for (depth = 1; depth <= params->max_queue_depth; depth *= 2)
+    {
+      if (deadline_reached (deadline, params))
+	break;
+
+      params->queue_depth = depth;
+      exec_repetition(0, deadline, params);
+
+      /* tests skipped by the deadline keep the timers of the previous
+	 depth, and are left out */
+      gain = FALSE;
+      for (a = READ; a <= MIXED; a++)
+	{
+	  points[(3 * num_depths) + a].ran = task->tests_run[a];
+	  if (!enabled[a] || !task->tests_run[a])
+	    continue;
+
+	  summarize_test (a, 0, &points[(3 * num_depths) + a]);
+	  points[(3 * num_depths) + a].queue_depth = depth;
+	  if (num_depths == 0 ||
+	      points[(3 * num_depths) + a].bandwidth >=
+	      (1 + SWEEP_MIN_GAIN) * points[(3 * (num_depths - 1)) + a].bandwidth)
+	    gain = TRUE;
+	}
+
+      num_depths++;
+      if (!gain)
+	break;
+    }
+
+  display_sweep_results (points, num_depths, params);
+
+  free (points);
+} /* exec_sweep (iore_time_t, iore_params_t *) */
+
+/*
+ * Execute a sweep of the shift of all offsets, 0, misalignment, 2 *
+ * misalignment, ... up to misalignment_steps times misalignment, with a single
+ * repetition at each shift, so aligned and misaligned transfers of a shared
+ * file can be compared.
+ */
+static void
+exec_misalignment_sweep (iore_time_t deadline, iore_params_t *params)
+{
+  iore_point_t *points;
+  iore_size_t step = params->misalignment;
+  int enabled[3];
+  int num_shifts = 0;
+  int k, a;
+
+  points = (iore_point_t *)
+    malloc (3 * (params->misalignment_steps + 1) * sizeof (iore_point_t));
+  if (points == NULL)
+    {
+      FATAL("Failed to allocate memory for the sweep results");
+      MPI_Abort(MPI_COMM_WORLD, -1);
+    }
+
+  enabled[READ] = params->read_test;
+  enabled[WRITE] = params->write_test;
+  enabled[MIXED] = params->mixed_test;
+
+  for (k = 0; k <= params->misalignment_steps; k++)
+    {
+      if (deadline_reached (deadline, params))
+	break;
+
+      params->misalignment = k * step;
+      exec_repetition(0, deadline, params);
+
+      /* tests skipped by the deadline are left out */
+      for (a = READ; a <= MIXED; a++)
+	{
+	  points[(3 * num_shifts) + a].ran = task->tests_run[a];
+	  if (!enabled[a] || !task->tests_run[a])
+	    continue;
+
+	  summarize_test (a, 0, &points[(3 * num_shifts) + a]);
+	  points[(3 * num_shifts) + a].misalignment = k * step;
+	}
+
+      num_shifts++;
+    }
+  params->misalignment = step;
+
+  display_misalignment_results (points, num_shifts, params);
+
+  free (points);
+} /* exec_misalignment_sweep (iore_time_t, iore_params_t *) */
+
 /*
  * Execute a write performance test.
  */
@@ -282,9 +564,9 @@ static void
 exec_write_test (int r, iore_params_t *params)
 {
   char *file_name;
-  iore_offset_t *offsets = NULL;
+  iore_offsets_t *offsets = NULL;
   void *buf = NULL;
-  void *fd;
+  void **fds;
 
   file_name = get_test_file_name (params, WRITE, r);
   if (task->verbosity >= VERY_VERBOSE)
@@ -293,18 +575,29 @@ exec_write_test (int r, iore_params_t *params)
 
   delay_secs (params->inter_test_delay);
 
-  if (!params->use_existing_file)
+  /* delta checkpoints rewrite part of the file of the previous repetition */
+  if (!params->use_existing_file && (r == 0 || params->dirty_fraction == 1))
     remove_file (params);
 
-  setup_io (WRITE, params, &offsets, &buf);
+  setup_io (WRITE, r, params, &offsets, &buf);
 
   MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
 
   /* create and open the test file */
   task->timer[W_OPEN_START][r] = current_time ();
-  fd = task->aio_backend->create (params);
+  fds = open_test_files (TRUE, params);
   task->timer[W_OPEN_STOP][r] = current_time ();
 
+  /* preallocate the test file, or make it sparse */
+  if (params->preallocation != NO_PREALLOCATION)
+    {
+      MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+      task->timer[A_START][r] = current_time ();
+      prepare_test_files (fds, offsets, params);
+      task->timer[A_STOP][r] = current_time ();
+    }
+
   if (params->intra_test_barrier)
     MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
 
@@ -313,15 +606,21 @@ exec_write_test (int r, iore_params_t *params)
 
   /* write file */
   task->timer[W_START][r] = current_time ();
-  task->data_moved[WRITE][r] = perform_io (fd, WRITE, offsets, buf, params);
+  task->data_moved[WRITE][r] = perform_io (fds, WRITE, r, offsets, buf,
+					       params);
   task->timer[W_STOP][r] = current_time ();
 
   if (params->intra_test_barrier)
     MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
 
+  /* flush the test file */
+  task->timer[W_SYNC_START][r] = current_time ();
+  sync_test_files (fds, params);
+  task->timer[W_SYNC_STOP][r] = current_time ();
+
   /* close the test file */
   task->timer[W_CLOSE_START][r] = current_time();
-  task->aio_backend->close (fd, params);
+  close_test_files (fds, params);
   task->timer[W_CLOSE_STOP][r] = current_time();
 
   cleanup_io (&offsets, &buf);
@@ -332,6 +631,12 @@ exec_write_test (int r, iore_params_t *params)
     display_per_task_results (WRITE, r);
 
   display_test_results (WRITE, r);
+
+  if (params->preallocation != NO_PREALLOCATION)
+    display_alloc_results (r, params->preallocation);
+
+  if (r > 0 && params->dirty_fraction < 1)
+    display_delta_results (r, params->dirty_fraction);
 } /* exec_write_test (int, iore_params_t *) */
 
 /*
@@ -341,9 +646,12 @@ static void
 exec_read_test (int r, iore_params_t *params)
 {
   char *file_name;
-  iore_offset_t *offsets = NULL;
+  iore_offsets_t *offsets = NULL;
   void *buf = NULL;
-  void *fd;
+  void **fds;
+  iore_time_t evict_time = 0;
+  iore_size_t resident = 0;
+  iore_size_t file_size = 0;
 
   file_name = get_test_file_name (params, READ, r);
   if (task->verbosity >= VERY_VERBOSE)
@@ -352,13 +660,20 @@ exec_read_test (int r, iore_params_t *params)
   
   delay_secs (params->inter_test_delay);
 
-  setup_io (READ, params, &offsets, &buf);
+  setup_io (READ, r, params, &offsets, &buf);
 
   MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
 
+  /* cache-cold reads */
+  if (params->drop_cache_before_read)
+    {
+      evict_test_files (&evict_time, &resident, &file_size, params);
+      MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+    }
+
   /* open the test file */
   task->timer[R_OPEN_START][r] = current_time ();
-  fd = task->aio_backend->open (params);
+  fds = open_test_files (FALSE, params);
   task->timer[R_OPEN_STOP][r] = current_time ();
 
   if (params->intra_test_barrier)
@@ -369,15 +684,20 @@ exec_read_test (int r, iore_params_t *params)
 
   /* read file */
   task->timer[R_START][r] = current_time ();
-  task->data_moved[READ][r] = perform_io (fd, READ, offsets, buf, params);
+  task->data_moved[READ][r] = perform_io (fds, READ, r, offsets, buf,
+					      params);
   task->timer[R_STOP][r] = current_time ();
 
   if (params->intra_test_barrier)
     MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
 
+  /* reads leave nothing to flush */
+  task->timer[R_SYNC_START][r] = current_time ();
+  task->timer[R_SYNC_STOP][r] = task->timer[R_SYNC_START][r];
+
   /* close the test file */
   task->timer[R_CLOSE_START][r] = current_time();
-  task->aio_backend->close (fd, params);
+  close_test_files (fds, params);
   task->timer[R_CLOSE_STOP][r] = current_time();
 
   cleanup_io (&offsets, &buf);
@@ -388,148 +708,1597 @@ exec_read_test (int r, iore_params_t *params)
     display_per_task_results (READ, r);
 
   display_test_results (READ, r);
+
+  if (params->drop_cache_before_read)
+    display_evict_results (r, evict_time, resident, file_size);
 } /* exec_read_test (int, iore_params_t *) */
 
 /*
- * Prepare the execution of an experiment run.
+ * Execute a mixed read/write performance test over the file of the previous
+ * tests. Each transfer is a read with probability read_fraction, or a write
+ * otherwise, so reads and writes of a task are interleaved in a single pass.
  */
 static void
-setup_run (iore_params_t *params)
+exec_mixed_test (int r, iore_params_t *params)
 {
-  setup_mpi_comm (params);
+  char *file_name;
+  iore_offsets_t *offsets = NULL;
+  void *buf = NULL;
+  void **fds;
 
-  /* only tasks participating in this run */
-  if (task->comm != MPI_COMM_NULL)
-    {
-      setup_perf_collectors(params->num_repetitions);
-      bind_aio_backend(params->api);
-    }
-} /* setup_run (iore_params_t *) */
+  file_name = get_test_file_name (params, MIXED, r);
+  if (task->verbosity >= VERY_VERBOSE)
+    INFOF("Task %d reading from and writing to file %s\n", task->rank,
+	  file_name);
+  task->test_file_name = file_name;
+
+  delay_secs (params->inter_test_delay);
+
+  setup_io (MIXED, r, params, &offsets, &buf);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  /* open the test file */
+  task->timer[M_OPEN_START][r] = current_time ();
+  fds = open_test_files (FALSE, params);
+  task->timer[M_OPEN_STOP][r] = current_time ();
+
+  if (params->intra_test_barrier)
+    MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  if (task->rank == MASTER_RANK && task->verbosity >= VERBOSE)
+    INFOF("Starting mixed performance test: %s", current_time_str ());
+
+  /* read and write file */
+  task->timer[M_START][r] = current_time ();
+  task->data_moved[MIXED][r] = perform_io (fds, MIXED, r, offsets, buf,
+					   params);
+  task->timer[M_STOP][r] = current_time ();
+
+  if (params->intra_test_barrier)
+    MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  /* flush the test file */
+  task->timer[M_SYNC_START][r] = current_time ();
+  sync_test_files (fds, params);
+  task->timer[M_SYNC_STOP][r] = current_time ();
+
+  /* close the test file */
+  task->timer[M_CLOSE_START][r] = current_time();
+  close_test_files (fds, params);
+  task->timer[M_CLOSE_STOP][r] = current_time();
+
+  cleanup_io (&offsets, &buf);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  if (task->verbosity >= DEBUG)
+    display_per_task_results (MIXED, r);
+
+  display_test_results (MIXED, r);
+} /* exec_mixed_test (int, iore_params_t *) */
 
 /*
- * Reset performance timers to collect results from an experiment run.
- */ 
+ * Execute a read-modify-write update test over the file of the previous
+ * tests. Each transfer is an update of a record at a random offset in its
+ * slot: the fs_block_size aligned window around the record is read, the
+ * record is copied into it, and the window is written back, as done by
+ * record-oriented codes updating unaligned records.
+ */
 static void
-setup_perf_collectors (int num_repetitions)
+exec_update_test (int r, iore_params_t *params)
 {
-  int i;
-  for (i = 0; i < NUM_TIMERS; i++)
-    {
-      task->timer[i] = (iore_time_t *)
-	malloc(num_repetitions * sizeof(iore_time_t));
-      if (task->timer[i] == NULL)
-	{
-	  FATAL("Failed to setup performance timers");
-	  MPI_Abort(MPI_COMM_WORLD, -1);
-	}
-    }
+  char *file_name;
+  iore_offsets_t *offsets = NULL;
+  void *buf = NULL;
+  void **fds;
 
-  task->data_moved[READ] = (iore_size_t *)
-    malloc (num_repetitions * sizeof (iore_size_t));
-  if (task->data_moved[READ] == NULL)
-    {
-      FATAL("Failed to setup data moved collector");
-      MPI_Abort(MPI_COMM_WORLD, -1);
-    }
+  file_name = get_test_file_name (params, UPDATE, r);
+  if (task->verbosity >= VERY_VERBOSE)
+    INFOF("Task %d updating file %s\n", task->rank, file_name);
+  task->test_file_name = file_name;
 
-  task->data_moved[WRITE] = (iore_size_t *)
-    malloc (num_repetitions * sizeof (iore_size_t));
-  if (task->data_moved[WRITE] == NULL)
-    {
-      FATAL("Failed to setup data moved collector");
-      MPI_Abort(MPI_COMM_WORLD, -1);
-    }
-} /* setup_perf_collectors (int) */
+  delay_secs (params->inter_test_delay);
+
+  setup_io (UPDATE, r, params, &offsets, &buf);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  /* open the test file */
+  task->timer[U_OPEN_START][r] = current_time ();
+  fds = open_test_files (FALSE, params);
+  task->timer[U_OPEN_STOP][r] = current_time ();
+
+  if (params->intra_test_barrier)
+    MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  if (task->rank == MASTER_RANK && task->verbosity >= VERBOSE)
+    INFOF("Starting update performance test: %s", current_time_str ());
+
+  /* update file */
+  task->timer[U_START][r] = current_time ();
+  task->data_moved[UPDATE][r] = perform_io (fds, UPDATE, r, offsets, buf,
+					    params);
+  task->timer[U_STOP][r] = current_time ();
+
+  if (params->intra_test_barrier)
+    MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  /* flush the test file */
+  task->timer[U_SYNC_START][r] = current_time ();
+  sync_test_files (fds, params);
+  task->timer[U_SYNC_STOP][r] = current_time ();
+
+  /* close the test file */
+  task->timer[U_CLOSE_START][r] = current_time();
+  close_test_files (fds, params);
+  task->timer[U_CLOSE_STOP][r] = current_time();
+
+  cleanup_io (&offsets, &buf);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  if (task->verbosity >= DEBUG)
+    display_per_task_results (UPDATE, r);
+
+  display_test_results (UPDATE, r);
+} /* exec_update_test (int, iore_params_t *) */
 
 /*
- * Setup offsets and buffers for read and write tests.
+ * Execute a hole punching phase after the tests: each task deallocates the
+ * transfers of its write test, one hole per transfer, keeping the size of the
+ * file.
  */
 static void
-setup_io (access_t access, iore_params_t *params, iore_offset_t **offsets,
-	  void **buf)
+exec_punch_phase (int r, iore_params_t *params)
 {
-  int pretend_rank;
-  int i;
+  iore_offsets_t *offsets = NULL;
+  void *buf = NULL;
+  void **fds;
+  iore_offset_t offset;
+  iore_size_t size, file_size;
+  iore_size_t num_holes = 0;
+  iore_size_t data_freed = 0;
+  void *fd;
 
-  pretend_rank = get_pretend_rank (params, access);
+  task->test_file_name = get_test_file_name (params, WRITE, r);
 
-  i = pretend_rank % params->block_sizes_length;
-  task->block_size = params->block_sizes[i];
+  setup_io (WRITE, r, params, &offsets, &buf);
 
-  i = pretend_rank % params->transfer_sizes_length;
-  task->transfer_size = params->transfer_sizes[i];
+  /* after a stonewalled write, only the first wear_out_count offsets, those
+     written, are punched */
+  if (task->wear_out_count >= 0)
+    limit_offsets (offsets, task->wear_out_count, params);
+
+  fds = open_test_files (FALSE, params);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  task->timer[H_START][r] = current_time ();
+  while (next_offset (offsets, &offset, &size))
+    {
+      fd = fds[0];
+      if (offsets->num_files > 1)
+	fd = fds[spread_offset (offsets, &offset, &file_size)];
+      offset += params->misalignment;
+
+      task->aio_backend->punch (fd, offset, size, params);
+      num_holes++;
+      data_freed += size;
+    }
+  task->timer[H_STOP][r] = current_time ();
+
+  close_test_files (fds, params);
+  cleanup_io (&offsets, &buf);
 
-  if (params->access_pattern == SEQUENTIAL)
-    *offsets = get_sequential_offsets (pretend_rank, params);
-  else /* RANDOM */
-    *offsets = get_random_offsets (pretend_rank, params);
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
 
-  *buf = get_buffer (access, pretend_rank);
-} /* setup_io (access_t, iore_params_t *, iore_offset_t *, void *) */
+  display_punch_results (r, num_holes, data_freed);
+} /* exec_punch_phase (int, iore_params_t *) */
 
 /*
- * Deallocate the memory used for file offsets and I/O buffers.
+ * Prepare the open files of a write test. FALLOCATE reserves the blocks of
+ * each file, every task the slice of the file matching its rank in a shared
+ * file, and SPARSE_FILE sets the size of each file, by the master rank in a
+ * shared file.
  */
 static void
-cleanup_io (iore_offset_t **offsets, void **buf)
+prepare_test_files (void **fds, iore_offsets_t *offsets,
+		    iore_params_t *params)
 {
-  free (*offsets);
-  free (*buf);
-} /* cleanup_io (iore_offset_t **, void **) */
+  iore_offset_t first;
+  iore_size_t file_size;
+  iore_size_t length;
+  int f;
+
+  for (f = 0; f < params->open_files_per_task; f++)
+    {
+      file_size = get_spread_file_size (offsets, f);
+
+      if (params->sharing_policy == FILE_PER_PROCESS)
+	{
+	  first = 0;
+	  length = file_size;
+	}
+      else
+	{
+	  first = (file_size * task->rank) / params->num_tasks;
+	  length = ((file_size * (task->rank + 1)) / params->num_tasks) -
+	    first;
+	}
+
+      if (params->preallocation == FALLOCATE && length > 0)
+	task->aio_backend->allocate (fds[f], first, length, params);
+      else if (params->preallocation == SPARSE_FILE &&
+	       (params->sharing_policy == FILE_PER_PROCESS ||
+		task->rank == MASTER_RANK))
+	task->aio_backend->truncate (fds[f], file_size, params);
+    }
+} /* prepare_test_files (void **, iore_offsets_t *, iore_params_t *) */
 
 /*
- * Bind an abstract I/O implementation to the backend.
+ * Execute the life cycle of a simulation: each checkpoint is a compute phase
+ * followed by a write test on the checkpoint file, and a final read test
+ * restarts from the last checkpoint. The time to solution spans the whole
+ * cycle; the I/O time of a task is the sum of its open to close times.
  */
 static void
-bind_aio_backend (char *api)
+exec_checkpoint_workload (int r, iore_time_t deadline, iore_params_t *params)
 {
-  iore_aio_t *backend = NULL;
-  iore_aio_t **aio = available_aio;
+  iore_time_t start;
+  iore_time_t compute_time = 0;
+  iore_time_t io_time = 0;
+  iore_time_t t;
+  int c;
 
-  while (*aio != NULL && backend == NULL)
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+  start = current_time ();
+
+  for (c = 0; c < params->num_checkpoints; c++)
     {
-      if (STREQUAL(api, (*aio)->name))
-	backend = *aio;
+      if (deadline_reached (deadline, params))
+	break;
 
-      aio++;
+      t = current_time ();
+      compute (params->compute_time, params->compute_busy);
+      compute_time += current_time () - t;
+
+      exec_write_test (r, params);
+      io_time += task->timer[W_CLOSE_STOP][r] - task->timer[W_OPEN_START][r];
     }
 
-  if (backend == NULL)
-    FATALF("Unrecognized abstract I/O API: %s.", api);
-  else
-    task->aio_backend = backend;
-} /* bind_aio_backend (char *) */
+  /* restart from the last checkpoint written */
+  if (c > 0)
+    {
+      exec_read_test (r, params);
+      io_time += task->timer[R_CLOSE_STOP][r] - task->timer[R_OPEN_START][r];
+    }
+
+  display_checkpoint_results (current_time () - start, compute_time, io_time,
+			      c);
+} /* exec_checkpoint_workload (int, iore_time_t, iore_params_t *) */
 
 /*
- * Generates a data signatures to be used in write tests.
+ * Simulate a compute phase of a given duration in seconds, either sleeping or
+ * keeping the core busy in a floating point loop.
  */
 static void
-setup_data_signature ()
+compute (double secs, int busy)
 {
-  time_t curtime;
+  volatile double x = 1.0;
+  iore_time_t end = current_time () + secs;
 
-  curtime = time(NULL);
-  if (curtime == -1)
-    FATAL("Failed to generate data signature.");
+  if (!busy)
+    {
+      wait_until (end);
+      return;
+    }
 
-  task->data_signature = curtime;
-} /* setup_data_signature () */
+  while (current_time () < end)
+    x = (x * 1.000001) + 1e-9;
+} /* compute (double, int) */
 
 /*
- * Returns the actual file name used for tests. It may include suffixes and
- * prefixes depending on supplied parameters.
+ * Execute the emulation of the data loader of a training job. Tasks first
+ * write the shards of the dataset, spread over the tasks, with a transfer for
+ * each sample. In each epoch, all tasks compute the same shuffle of the whole
+ * dataset and each task reads a disjoint slice of it through its prefetch
+ * threads, consuming the samples in the order they are read. Latencies are
+ * those of the sample reads, without the time spent in the queue.
  */
-static char *
-get_test_file_name (iore_params_t *params, access_t access, int r)
+static void
+exec_loader_workload (int r, iore_time_t deadline, iore_params_t *params)
 {
-  char *file_name = (char *) malloc(MAX_STR_LEN * sizeof(char));
-  char *tmp = (char *) malloc(MAX_STR_LEN * sizeof(char)); 
-  int pretend_rank;
-  
-  if (params->sharing_policy == SHARED_FILE)
-    strcpy (file_name, params->root_file_name);
-  else
-    { /* FILE_PER_PROCESS */
+  iore_dataset_t *dataset;
+  iore_prefetch_t *prefetch;
+  iore_fetched_t fetched;
+  iore_trace_record_t rec;
+  iore_samples_t *samples = &task->samples[READ];
+  iore_hist_t *hist;
+  iore_perm_t perm;
+  iore_size_t data_moved = 0;
+  iore_size_t epoch_moved, epoch_count;
+  iore_size_t first, last, i;
+  iore_time_t start;
+  unsigned long long stream;
+  void *buf;
+  void **fds;
+  int e, f;
+
+  stream = (1ULL << 61) | ((unsigned long long) r << 32);
+  dataset = new_dataset (params->num_shards, params->samples_per_shard,
+			 params->sample_size, params->max_sample_size,
+			 params->random_seed, stream);
+
+  fds = (void **) calloc (params->num_shards, sizeof (void *));
+  hist = (iore_hist_t *) malloc (sizeof (iore_hist_t));
+  if (fds == NULL || hist == NULL)
+    {
+      FATAL("Failed to allocate memory for the data loader");
+      MPI_Abort(MPI_COMM_WORLD, -1);
+    }
+
+  task->num_files = params->num_shards;
+  task->stonewall_time = -1;
+
+  delay_secs (params->inter_test_delay);
+
+  /* buffers hold the largest sample, rounded up to the pattern words */
+  task->transfer_size = ((dataset->max_size + sizeof (unsigned long long) - 1) /
+			 sizeof (unsigned long long)) *
+    sizeof (unsigned long long);
+  buf = get_buffer (WRITE, task->rank, 1);
+
+  reset_hist (&task->samples[WRITE].latency[WRITE]);
+  task->samples[WRITE].moved[WRITE] = 0;
+  task->sync_time = 0;
+  task->sync_count = 0;
+  memset (&rec, 0, sizeof (rec));
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  /* create the shards of the task */
+  task->timer[W_OPEN_START][r] = current_time ();
+  for (f = task->rank; f < params->num_shards; f += params->num_tasks)
+    {
+      task->test_file_name = get_workload_file_name (params, f, r);
+      fds[f] = task->aio_backend->create (params);
+      free (task->test_file_name);
+    }
+  task->timer[W_OPEN_STOP][r] = current_time ();
+
+  if (params->intra_test_barrier)
+    MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  /* write the samples of the shards */
+  task->timer[W_START][r] = current_time ();
+  task->phase = WRITE;
+  task->phase_start = task->timer[W_START][r];
+  rec.op = WRITE;
+  for (f = task->rank; f < params->num_shards; f += params->num_tasks)
+    for (i = f * dataset->samples_per_shard;
+	 i < (f + 1) * dataset->samples_per_shard; i++)
+      {
+	rec.file = f;
+	rec.offset = sample_offset (dataset, i);
+	rec.length = sample_size (dataset, i);
+	if (task->capture != NULL)
+	  rec.start = current_time ();
+	rec.result = task->aio_backend->io (fds[f], buf, rec.length,
+					    rec.offset, WRITE, params);
+	data_moved += check_io (&rec, NULL);
+      }
+  task->timer[W_STOP][r] = current_time ();
+  task->data_moved[WRITE][r] = data_moved;
+
+  if (params->intra_test_barrier)
+    MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  task->timer[W_SYNC_START][r] = current_time ();
+  for (f = task->rank; f < params->num_shards; f += params->num_tasks)
+    sync_test_file (fds[f], params);
+  task->timer[W_SYNC_STOP][r] = current_time ();
+
+  task->timer[W_CLOSE_START][r] = current_time ();
+  for (f = task->rank; f < params->num_shards; f += params->num_tasks)
+    task->aio_backend->close (fds[f], params);
+  task->timer[W_CLOSE_STOP][r] = current_time ();
+
+  free (buf);
+  if (task->capture != NULL)
+    flush_capture (task->capture);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  display_test_results (WRITE, r);
+
+  /* open all shards, as any task reads from any shard */
+  reset_hist (&samples->latency[READ]);
+  samples->moved[READ] = 0;
+  data_moved = 0;
+
+  task->timer[R_OPEN_START][r] = current_time ();
+  for (f = 0; f < params->num_shards; f++)
+    {
+      task->test_file_name = get_workload_file_name (params, f, r);
+      fds[f] = task->aio_backend->open (params);
+      free (task->test_file_name);
+    }
+  task->timer[R_OPEN_STOP][r] = current_time ();
+
+  /* the slice of each task in the shuffled order of the samples */
+  first = (dataset->num_samples * task->rank) / params->num_tasks;
+  last = (dataset->num_samples * (task->rank + 1)) / params->num_tasks;
+
+  task->timer[R_START][r] = current_time ();
+  for (e = 0; e < params->num_epochs; e++)
+    {
+      if (deadline_reached (deadline, params))
+	break;
+
+      setup_perm (&perm, params->random_seed, (1ULL << 60) |
+		  ((unsigned long long) r << 32) | (unsigned long long) e,
+		  dataset->num_samples);
+      reset_hist (hist);
+      epoch_moved = 0;
+      epoch_count = 0;
+
+      MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+      start = current_time ();
+      prefetch = new_prefetch (dataset, fds, &perm, first, last,
+			       params->prefetch_threads,
+			       params->prefetch_depth, task->aio_backend,
+			       params);
+      while (next_sample (prefetch, &fetched))
+	{
+	  if (fetched.moved != sample_size (dataset, fetched.sample))
+	    {
+	      FATAL("Failed to read from file");
+	      MPI_Abort(MPI_COMM_WORLD, -1);
+	    }
+
+	  hist_add (hist, fetched.latency);
+	  epoch_moved += fetched.moved;
+	  epoch_count++;
+	  release_sample (prefetch, &fetched);
+	}
+      close_prefetch (prefetch);
+
+      display_epoch_results (e, current_time () - start, epoch_count,
+			     epoch_moved, hist);
+
+      merge_hist (hist, &samples->latency[READ]);
+      samples->moved[READ] += epoch_moved;
+      data_moved += epoch_moved;
+    }
+  task->timer[R_STOP][r] = current_time ();
+  task->data_moved[READ][r] = data_moved;
+
+  task->timer[R_SYNC_START][r] = current_time ();
+  task->timer[R_SYNC_STOP][r] = task->timer[R_SYNC_START][r];
+
+  task->timer[R_CLOSE_START][r] = current_time ();
+  for (f = 0; f < params->num_shards; f++)
+    task->aio_backend->close (fds[f], params);
+  task->timer[R_CLOSE_STOP][r] = current_time ();
+
+  free (hist);
+  free (fds);
+  free_dataset (dataset);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  display_test_results (READ, r);
+} /* exec_loader_workload (int, iore_time_t, iore_params_t *) */
+
+/*
+ * Execute a sweep of log appends by 1, 2, 4, ... and finally all tasks. At
+ * each step, each appending task appends records_per_task records to its log
+ * file, shared by groups of appenders_per_file tasks (all tasks if zero) and
+ * opened in append mode, so the file system serializes the appends to a file
+ * instead of the tasks placing them at distinct offsets. Logs grow over the
+ * steps of a repetition.
+ */
+static void
+exec_append_workload (int r, iore_time_t deadline, iore_params_t *params)
+{
+  iore_samples_t *samples = &task->samples[WRITE];
+  iore_size_t data_moved;
+  iore_size_t n;
+  iore_time_t start, elapsed, t;
+  void *buf;
+  void *fd;
+  int group, appenders, i;
+
+  group = (params->appenders_per_file > 0) ? params->appenders_per_file :
+    params->num_tasks;
+  task->num_files = (params->num_tasks + group - 1) / group;
+  task->stonewall_time = -1;
+
+  delay_secs (params->inter_test_delay);
+
+  /* the buffer holds a record, rounded up to the pattern words */
+  task->transfer_size = ((params->record_size + sizeof (unsigned long long) -
+			  1) / sizeof (unsigned long long)) *
+    sizeof (unsigned long long);
+  buf = get_buffer (WRITE, task->rank, 1);
+
+  display_append_header ();
+
+  for (appenders = 1; ; appenders *= 2)
+    {
+      if (appenders > params->num_tasks)
+	appenders = params->num_tasks;
+
+      if (deadline_reached (deadline, params))
+	break;
+
+      reset_hist (&samples->latency[WRITE]);
+      data_moved = 0;
+      elapsed = 0;
+
+      MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+      start = current_time ();
+      if (task->rank < appenders)
+	{
+	  task->test_file_name = get_workload_file_name (params,
+							 task->rank / group,
+							 r);
+	  fd = task->aio_backend->open_append (params);
+	  free (task->test_file_name);
+
+	  for (i = 0; i < params->records_per_task; i++)
+	    {
+	      t = current_time ();
+	      n = task->aio_backend->append (fd, buf, params->record_size,
+					     params);
+	      if (n != params->record_size)
+		{
+		  FATAL("Failed to append to file");
+		  MPI_Abort(MPI_COMM_WORLD, -1);
+		}
+	      hist_add (&samples->latency[WRITE], current_time () - t);
+	      data_moved += n;
+	    }
+
+	  task->aio_backend->close (fd, params);
+	  elapsed = current_time () - start;
+	}
+
+      display_append_results (appenders, (appenders + group - 1) / group,
+			      elapsed, data_moved, &samples->latency[WRITE]);
+
+      if (appenders == params->num_tasks)
+	break;
+    }
+
+  free (buf);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+} /* exec_append_workload (int, iore_time_t, iore_params_t *) */
+
+/*
+ * Execute a many-small-files workload: each task creates, writes and closes
+ * files_per_task files in turn, then reads back those of its pretend rank in
+ * the same way. The i-th file of task t is root_file_name.<t * files_per_task
+ * + i>, with a size drawn from the size distribution, so each file is a single
+ * transfer and the per-file costs of the file system dominate.
+ */
+static void
+exec_files_workload (int r, iore_time_t deadline, iore_params_t *params)
+{
+  iore_sizes_t *sizes;
+  iore_trace_record_t rec;
+  iore_samples_t *samples;
+  iore_size_t num_files;
+  iore_size_t data_moved;
+  access_t phases[2] = { WRITE, READ };
+  int start_timers[2] = { R_START, W_START };
+  int stop_timers[2] = { R_STOP, W_STOP };
+  void *bufs[2];
+  void *fd;
+  iore_size_t file;
+  int owner, p, i;
+
+  sizes = new_sizes (params, (1ULL << 58) | ((unsigned long long) r << 32));
+
+  task->num_files = (iore_size_t) params->num_tasks * params->files_per_task;
+  task->stonewall_time = -1;
+
+  delay_secs (params->inter_test_delay);
+
+  /* buffers hold the largest file, rounded up to the pattern words */
+  task->transfer_size = ((sizes->max_size + sizeof (unsigned long long) - 1) /
+			 sizeof (unsigned long long)) *
+    sizeof (unsigned long long);
+  bufs[WRITE] = get_buffer (WRITE, task->rank, 1);
+  bufs[READ] = get_buffer (READ, task->rank, 1);
+
+  memset (&rec, 0, sizeof (rec));
+
+  for (p = 0; p < 2; p++)
+    {
+      if (deadline_reached (deadline, params))
+	break;
+
+      rec.op = phases[p];
+      owner = get_pretend_rank (params, rec.op);
+      samples = &task->samples[rec.op];
+      reset_hist (&samples->latency[rec.op]);
+      samples->moved[rec.op] = 0;
+      num_files = 0;
+      data_moved = 0;
+
+      MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+      task->phase = rec.op;
+      task->phase_start = current_time ();
+      task->timer[start_timers[rec.op]][r] = task->phase_start;
+      for (i = 0; i < params->files_per_task; i++)
+	{
+	  /* file indexes may not fit the records, which only a capture uses */
+	  file = ((iore_size_t) owner * params->files_per_task) + i;
+	  if (task->capture != NULL)
+	    rec.file = file;
+	  rec.length = draw_size (sizes, file);
+	  task->test_file_name = get_workload_file_name (params, file, r);
+
+	  rec.start = current_time ();
+	  if (rec.op == WRITE)
+	    fd = task->aio_backend->create (params);
+	  else
+	    fd = task->aio_backend->open (params);
+	  rec.result = task->aio_backend->io (fd, bufs[rec.op], rec.length, 0,
+					      rec.op, params);
+	  if (rec.op == WRITE)
+	    sync_test_file (fd, params);
+	  task->aio_backend->close (fd, params);
+	  free (task->test_file_name);
+
+	  /* the latency of a file spans its open, transfer and close */
+	  data_moved += check_io (&rec, samples);
+	  num_files++;
+	}
+      task->timer[stop_timers[rec.op]][r] = current_time ();
+      task->data_moved[rec.op][r] = data_moved;
+
+      if (task->capture != NULL)
+	flush_capture (task->capture);
+
+      display_files_results (rec.op, r, task->timer[stop_timers[rec.op]][r] -
+			     task->phase_start, num_files, data_moved,
+			     &samples->latency[rec.op]);
+    }
+
+  free (bufs[WRITE]);
+  free (bufs[READ]);
+  free_sizes (sizes);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+} /* exec_files_workload (int, iore_time_t, iore_params_t *) */
+
+/*
+ * Execute a read-after-write visibility workload: the master rank writes
+ * visibility_records records, each stamped with its sequence number and write
+ * time, at the start of the file root_file_name.0, while the other tasks poll
+ * that offset until they read the new sequence number, for at most
+ * visibility_timeout seconds. Each record starts at a barrier, and a reader
+ * measures its delay from the barrier, with its own clock, so the clocks of
+ * the nodes need not be synchronized. Records are handed over by a plain
+ * write, a write followed by fsync, and a write between an open and a close
+ * of the file, in turn; in the last mode readers also reopen the file at each
+ * poll, as close-to-open consistency requires. Readers should run on other
+ * nodes than the master rank for the delays to be meaningful.
+ */
+static void
+exec_visibility_workload (int r, iore_params_t *params)
+{
+  iore_hist_t *delays;
+  iore_size_t timeouts;
+  iore_time_t start, now;
+  unsigned long long *rec;
+  handoff_t h;
+  void *fd;
+  int n;
+
+  task->num_files = 1;
+  task->stonewall_time = -1;
+  task->test_file_name = get_workload_file_name (params, 0, r);
+
+  rec = (unsigned long long *) malloc (params->record_size);
+  delays = (iore_hist_t *) malloc (sizeof (iore_hist_t));
+  if (rec == NULL || delays == NULL)
+    {
+      FATAL("Failed to allocate memory for the visibility records");
+      MPI_Abort(MPI_COMM_WORLD, -1);
+    }
+  memset (rec, 0, params->record_size);
+
+  delay_secs (params->inter_test_delay);
+
+  /* the initial record has a sequence number never written again */
+  if (task->rank == MASTER_RANK)
+    {
+      rec[0] = ~0ULL;
+      fd = task->aio_backend->create (params);
+      if (task->aio_backend->io (fd, (iore_size_t *) rec, params->record_size,
+				 0, WRITE, params) != params->record_size)
+	{
+	  FATAL("Failed to write to file");
+	  MPI_Abort(MPI_COMM_WORLD, -1);
+	}
+      task->aio_backend->sync (fd, params);
+      task->aio_backend->close (fd, params);
+    }
+
+  for (h = HANDOFF_WRITE; h < NUM_HANDOFFS; h++)
+    {
+      reset_hist (delays);
+      timeouts = 0;
+
+      MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+      fd = NULL;
+      if (h != HANDOFF_CLOSE)
+	fd = task->aio_backend->open (params);
+
+      for (n = 0; n < params->visibility_records; n++)
+	{
+	  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+	  start = current_time ();
+
+	  if (task->rank == MASTER_RANK)
+	    {
+	      rec[0] = ((unsigned long long) h << 32) | n;
+	      memcpy (&rec[1], &start, sizeof (start));
+
+	      if (h == HANDOFF_CLOSE)
+		fd = task->aio_backend->open (params);
+	      if (task->aio_backend->io (fd, (iore_size_t *) rec,
+					 params->record_size, 0, WRITE,
+					 params) != params->record_size)
+		{
+		  FATAL("Failed to write to file");
+		  MPI_Abort(MPI_COMM_WORLD, -1);
+		}
+	      if (h == HANDOFF_FSYNC)
+		task->aio_backend->sync (fd, params);
+	      if (h == HANDOFF_CLOSE)
+		task->aio_backend->close (fd, params);
+
+	      continue;
+	    }
+
+	  /* poll until the record is visible or the timeout expires */
+	  for (;;)
+	    {
+	      if (h == HANDOFF_CLOSE)
+		fd = task->aio_backend->open (params);
+	      if (task->aio_backend->io (fd, (iore_size_t *) rec,
+					 params->record_size, 0, READ,
+					 params) != params->record_size)
+		{
+		  FATAL("Failed to read from file");
+		  MPI_Abort(MPI_COMM_WORLD, -1);
+		}
+	      if (h == HANDOFF_CLOSE)
+		task->aio_backend->close (fd, params);
+
+	      now = current_time ();
+	      if (rec[0] == (((unsigned long long) h << 32) | n))
+		{
+		  hist_add (delays, now - start);
+		  break;
+		}
+	      if (now - start >= params->visibility_timeout)
+		{
+		  timeouts++;
+		  break;
+		}
+	    }
+	}
+
+      if (h != HANDOFF_CLOSE)
+	task->aio_backend->close (fd, params);
+
+      display_visibility_results (h, r, timeouts, delays);
+    }
+
+  free (rec);
+  free (delays);
+  free (task->test_file_name);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+} /* exec_visibility_workload (int, iore_params_t *) */
+
+/*
+ * Execute a metadata workload in the style of mdtest. A tree of tree_depth
+ * levels of tree_fanout subdirectories is built below root_file_name.tree,
+ * either a tree for each task (root_file_name.tree.<rank>) or a tree shared by
+ * all tasks and built by the master rank. Each task then creates empty files
+ * f.<rank>.<i>, items_per_dir in each directory, stats them, opens and closes
+ * them, lists the directories, renames the files to r.<rank>.<i> and unlinks
+ * them, before the tree is removed. Phases are separated by barriers, and
+ * their rates are reported over all tasks.
+ */
+static void
+exec_md_workload (int r, iore_params_t *params)
+{
+  iore_time_t starts[NUM_MD_PHASES];
+  iore_time_t stops[NUM_MD_PHASES];
+  iore_size_t counts[NUM_MD_PHASES];
+  char *test_file_name = task->test_file_name;
+  iore_size_t num_dirs = 1;
+  iore_size_t level = 1;
+  iore_size_t d;
+  char **dirs;
+  int length;
+  int p, i;
+
+  /* directories in breadth-first order; directory d > 0 is child number
+     (d - 1) % tree_fanout of directory (d - 1) / tree_fanout */
+  for (i = 0; i < params->tree_depth; i++)
+    {
+      level *= params->tree_fanout;
+      num_dirs += level;
+    }
+
+  dirs = (char **) malloc (num_dirs * sizeof (char *));
+  if (dirs == NULL)
+    {
+      FATAL("Failed to allocate memory for the directory tree");
+      MPI_Abort(MPI_COMM_WORLD, -1);
+    }
+
+  for (d = 0; d < num_dirs; d++)
+    {
+      dirs[d] = (char *) malloc (MAXPATHLEN * sizeof (char));
+      if (dirs[d] == NULL)
+	{
+	  FATAL("Failed to allocate memory for the directory tree");
+	  MPI_Abort(MPI_COMM_WORLD, -1);
+	}
+
+      if (d > 0)
+	length = snprintf (dirs[d], MAXPATHLEN, "%s/d%lld",
+			   dirs[(d - 1) / params->tree_fanout],
+			   (d - 1) % params->tree_fanout);
+      else if (params->unique_dir_per_task)
+	length = snprintf (dirs[d], MAXPATHLEN, "%s.tree.%d",
+			   params->root_file_name, task->rank);
+      else
+	length = snprintf (dirs[d], MAXPATHLEN, "%s.tree",
+			   params->root_file_name);
+
+      if (length >= MAXPATHLEN)
+	{
+	  FATAL("The directory tree is too deep for the path length limit");
+	  MPI_Abort(MPI_COMM_WORLD, -1);
+	}
+    }
+
+  delay_secs (params->inter_test_delay);
+
+  for (p = 0; p < NUM_MD_PHASES; p++)
+    {
+      MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+      starts[p] = current_time ();
+      counts[p] = exec_md_phase (p, dirs, num_dirs, params);
+      stops[p] = current_time ();
+    }
+
+  task->test_file_name = test_file_name;
+
+  display_md_results (r, starts, stops, counts);
+
+  for (d = 0; d < num_dirs; d++)
+    free (dirs[d]);
+  free (dirs);
+} /* exec_md_workload (int, iore_params_t *) */
+
+/*
+ * Execute the operations of a task in a phase of a metadata workload, and
+ * returns their number. Directories of a shared tree are created and removed
+ * by the master rank only, children after their parents and before them.
+ */
+static iore_size_t
+exec_md_phase (md_phase_t phase, char **dirs, iore_size_t num_dirs,
+	       iore_params_t *params)
+{
+  char name[MAXPATHLEN + 32]; /* room for the item suffix */
+  char new_name[MAXPATHLEN + 32];
+  iore_size_t count = 0;
+  iore_size_t d;
+  void *fd;
+  int i;
+
+  if (phase == MD_MKDIR || phase == MD_RMDIR)
+    {
+      if (!params->unique_dir_per_task && task->rank != MASTER_RANK)
+	return (0);
+
+      for (d = 0; d < num_dirs; d++)
+	{
+	  if (phase == MD_MKDIR &&
+	      task->aio_backend->mkdir (dirs[d], params) != 0)
+	    {
+	      FATALF("Failed to create directory %s", dirs[d]);
+	      MPI_Abort(MPI_COMM_WORLD, -1);
+	    }
+	  else if (phase == MD_RMDIR &&
+		   task->aio_backend->rmdir (dirs[num_dirs - 1 - d],
+					     params) != 0)
+	    {
+	      FATALF("Failed to remove directory %s", dirs[num_dirs - 1 - d]);
+	      MPI_Abort(MPI_COMM_WORLD, -1);
+	    }
+	  count++;
+	}
+
+      return (count);
+    }
+
+  if (phase == MD_READDIR)
+    {
+      for (d = 0; d < num_dirs; d++)
+	{
+	  if (task->aio_backend->readdir (dirs[d], params) < 0)
+	    {
+	      FATALF("Failed to list directory %s", dirs[d]);
+	      MPI_Abort(MPI_COMM_WORLD, -1);
+	    }
+	  count++;
+	}
+
+      return (count);
+    }
+
+  for (d = 0; d < num_dirs; d++)
+    for (i = 0; i < params->items_per_dir; i++)
+      {
+	snprintf (name, sizeof (name), "%s/f.%d.%d", dirs[d], task->rank, i);
+	snprintf (new_name, sizeof (new_name), "%s/r.%d.%d", dirs[d],
+		  task->rank, i);
+
+	switch (phase)
+	  {
+	  case MD_CREATE:
+	    task->test_file_name = name;
+	    fd = task->aio_backend->create (params);
+	    task->aio_backend->close (fd, params);
+	    break;
+
+	  case MD_STAT:
+	    if (task->aio_backend->stat (name, params) != 0)
+	      {
+		FATALF("Failed to stat file f.%d.%d of %s", task->rank, i,
+		       dirs[d]);
+		MPI_Abort(MPI_COMM_WORLD, -1);
+	      }
+	    break;
+
+	  case MD_OPEN:
+	    task->test_file_name = name;
+	    fd = task->aio_backend->open (params);
+	    task->aio_backend->close (fd, params);
+	    break;
+
+	  case MD_RENAME:
+	    if (task->aio_backend->rename (name, new_name, params) != 0)
+	      {
+		FATALF("Failed to rename file f.%d.%d of %s", task->rank, i,
+		       dirs[d]);
+		MPI_Abort(MPI_COMM_WORLD, -1);
+	      }
+	    break;
+
+	  default: /* MD_UNLINK */
+	    task->test_file_name = new_name;
+	    task->aio_backend->delete (params);
+	    break;
+	  }
+	count++;
+      }
+
+  return (count);
+} /* exec_md_phase (md_phase_t, char **, iore_size_t, iore_params_t *) */
+
+/*
+ * Execute the replay of the transfers of a trace, either a single file or a
+ * file for each rank, with the rank appended to the trace file name as in
+ * captured traces. Each task replays the
+ * records of its rank in trace order, on the files root_file_name.<file>
+ * (created if needed), either as fast as possible or at the recorded issue
+ * times; recorded times restart at each phase of the trace. Records of ranks
+ * not in the run are ignored. Before the replay, files are extended up to the
+ * end of their reads, so traces reading input they did not write replay on
+ * empty files.
+ *
+ * Every task walks all the records of a single trace file, twice, so with a
+ * large trace and many ranks the pages of the mapping are read by each rank;
+ * traces split per rank avoid it.
+ */
+static void
+exec_replay_test (int r, iore_params_t *params)
+{
+  iore_trace_t *trace;
+  iore_trace_record_t *rec;
+  iore_trace_record_t replayed;
+  iore_samples_t *samples = &task->samples[REPLAY];
+  char file_name[MAXPATHLEN + 32];
+  iore_size_t data_moved = 0;
+  iore_size_t max_length = 0;
+  iore_size_t i;
+  iore_time_t base = 0;
+  iore_time_t start;
+  void *buf[2];
+  void **fds;
+  iore_offset_t *extents;
+  iore_size_t num_files = 0;
+  int phase = -1;
+  int f;
+
+  delay_secs (params->inter_test_delay);
+
+  /* traces captured by iore have a file for each rank */
+  if (access (params->trace_file_name, F_OK) == 0)
+    trace = open_trace (params->trace_file_name);
+  else
+    {
+      snprintf (file_name, sizeof (file_name), "%s.%d",
+		params->trace_file_name, task->rank);
+      trace = open_trace (file_name);
+    }
+
+  fds = (void **) calloc (TRACE_MAX_FILES, sizeof (void *));
+  extents = (iore_offset_t *) calloc (TRACE_MAX_FILES,
+				      sizeof (iore_offset_t));
+  if (fds == NULL || extents == NULL)
+    {
+      FATAL("Failed to allocate memory for the replayed files");
+      MPI_Abort(MPI_COMM_WORLD, -1);
+    }
+
+  /* find the files, the largest transfer of the task and the end of the
+     reads of each file; files are marked as used until opened */
+  for (i = 0; i < trace->num_records; i++)
+    {
+      rec = &trace->records[i];
+      if (rec->rank != task->rank)
+	continue;
+
+      if (rec->file < 0 || rec->length < 0 ||
+	  (rec->op != READ && rec->op != WRITE))
+	{
+	  FATALF("Invalid record %lld in the trace", i);
+	  MPI_Abort(MPI_COMM_WORLD, -1);
+	}
+
+      fds[rec->file] = fds;
+      if (rec->file >= num_files)
+	num_files = rec->file + 1;
+      if (rec->length > max_length)
+	max_length = rec->length;
+      if (rec->op == READ && rec->offset + rec->length > extents[rec->file])
+	extents[rec->file] = rec->offset + rec->length;
+    }
+
+  MPI_TRYCATCH(MPI_Allreduce (&num_files, &task->num_files, 1,
+			      MPI_LONG_LONG_INT, MPI_MAX, task->comm),
+	       "Failed to count the replayed files");
+
+  /* replays run to the end of the trace */
+  task->stonewall_time = -1;
+
+  /* buffers hold the largest transfer, rounded up to the pattern words */
+  task->transfer_size = ((max_length + sizeof (unsigned long long) - 1) /
+			 sizeof (unsigned long long)) *
+    sizeof (unsigned long long);
+  buf[READ] = get_buffer (READ, task->rank, 1);
+  buf[WRITE] = get_buffer (WRITE, task->rank, 1);
+
+  reset_hist (&samples->latency[READ]);
+  reset_hist (&samples->latency[WRITE]);
+  samples->moved[READ] = 0;
+  samples->moved[WRITE] = 0;
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  /* create or open the files of the task */
+  task->timer[P_OPEN_START][r] = current_time ();
+  for (f = 0; f < num_files; f++)
+    if (fds[f] != NULL)
+      {
+	task->test_file_name = get_workload_file_name (params, f, r);
+	fds[f] = task->aio_backend->create (params);
+	free (task->test_file_name);
+      }
+  task->timer[P_OPEN_STOP][r] = current_time ();
+
+  /* extend the files up to their reads, outside of the timers; the blocks
+     are allocated, so files are never shrunk */
+  for (f = 0; f < num_files; f++)
+    if (fds[f] != NULL && extents[f] > 0)
+      {
+	if (task->aio_backend->allocate == NULL)
+	  {
+	    FATALF("The %s API cannot extend the replayed files",
+		   task->aio_backend->name);
+	    MPI_Abort(MPI_COMM_WORLD, -1);
+	  }
+	task->aio_backend->allocate (fds[f], 0, extents[f], params);
+      }
+
+  if (params->intra_test_barrier)
+    MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  if (task->rank == MASTER_RANK && task->verbosity >= VERBOSE)
+    INFOF("Starting trace replay: %s", current_time_str ());
+
+  /* replay the transfers */
+  task->timer[P_START][r] = current_time ();
+  task->phase = REPLAY;
+  task->phase_start = task->timer[P_START][r];
+  for (i = 0; i < trace->num_records; i++)
+    {
+      rec = &trace->records[i];
+      if (rec->rank != task->rank)
+	continue;
+
+      if (params->trace_timing)
+	{
+	  /* a new phase starts now */
+	  if (rec->phase != phase)
+	    {
+	      phase = rec->phase;
+	      base = current_time () - rec->start;
+	    }
+
+	  start = base + rec->start;
+	  wait_until (start);
+	}
+      else
+	{
+	  start = current_time ();
+	}
+
+      if (task->verbosity >= DEBUG)
+	INFOF("Task %d %s offset %lld of file %d\n", task->rank,
+	      (rec->op == WRITE ? "writing to" : "reading from"),
+	      (long long) rec->offset, rec->file);
+
+      replayed = *rec;
+      replayed.start = start;
+      replayed.result = task->aio_backend->io (fds[rec->file], buf[rec->op],
+					       rec->length, rec->offset,
+					       rec->op, params);
+      data_moved += check_io (&replayed, samples);
+    }
+  task->timer[P_STOP][r] = current_time ();
+  task->data_moved[REPLAY][r] = data_moved;
+
+  if (params->intra_test_barrier)
+    MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  /* flush the files */
+  task->timer[P_SYNC_START][r] = current_time ();
+  for (f = 0; f < num_files; f++)
+    if (fds[f] != NULL)
+      sync_test_file (fds[f], params);
+  task->timer[P_SYNC_STOP][r] = current_time ();
+
+  /* close the files */
+  task->timer[P_CLOSE_START][r] = current_time ();
+  for (f = 0; f < num_files; f++)
+    if (fds[f] != NULL)
+      task->aio_backend->close (fds[f], params);
+  task->timer[P_CLOSE_STOP][r] = current_time ();
+
+  free (buf[READ]);
+  free (buf[WRITE]);
+  free (fds);
+  free (extents);
+  close_trace (trace);
+
+  if (task->capture != NULL)
+    flush_capture (task->capture);
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  if (task->verbosity >= DEBUG)
+    display_per_task_results (REPLAY, r);
+
+  display_test_results (REPLAY, r);
+} /* exec_replay_test (int, iore_params_t *) */
+
+/*
+ * Prepare the execution of an experiment run.
+ */
+static void
+setup_run (iore_params_t *params)
+{
+  char file_name[MAXPATHLEN + 32];
+
+  setup_mpi_comm (params);
+
+  /* only tasks participating in this run */
+  if (task->comm != MPI_COMM_NULL)
+    {
+      setup_perf_collectors(params->num_repetitions);
+      bind_aio_backend(params->api);
+
+      /* random accesses are reproducible from the seed shown in the run
+	 summary */
+      if (params->random_seed < 0)
+	params->random_seed = task->random_seed;
+
+      validate_run (params);
+
+      /* each task captures its transfers in its own trace file */
+      task->capture = NULL;
+      if (params->trace_capture_file_name[0] != '\0')
+	{
+	  snprintf (file_name, sizeof (file_name), "%s.%d",
+		    params->trace_capture_file_name, task->rank);
+	  task->capture = new_capture (file_name,
+				       params->trace_buffer_records);
+	}
+    }
+} /* setup_run (iore_params_t *) */
+
+/*
+ * Check that the combination of parameters of a run is supported.
+ */
+static void
+validate_run (iore_params_t *params)
+{
+  if (params->mixed_test && !params->write_test &&
+      !params->use_existing_file)
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("The mixed test requires the write test or an existing file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->update_test && !params->write_test &&
+      !params->use_existing_file)
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("The update test requires the write test or an existing file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->arrival_process != CLOSED_LOOP &&
+      (params->target_iops > 0) == (params->target_bandwidth > 0))
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("Open loop arrival processes require either target_iops or "
+	    "target_bandwidth");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->workload == TRACE_REPLAY && params->trace_file_name[0] == '\0')
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("The TRACE_REPLAY workload requires a trace_file_name");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->workload == DATA_LOADER &&
+      task->thread_level < MPI_THREAD_MULTIPLE)
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("The DATA_LOADER workload requires an MPI library with "
+	    "MPI_THREAD_MULTIPLE support for its prefetch threads");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->workload == SMALL_FILES &&
+      params->trace_capture_file_name[0] != '\0' &&
+      (iore_size_t) params->num_tasks * params->files_per_task >
+      TRACE_MAX_FILES)
+    {
+      if (task->rank == MASTER_RANK)
+	ERRF("Trace captures of the SMALL_FILES workload support at most %d "
+	     "files", TRACE_MAX_FILES);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->workload == LOG_APPEND && task->aio_backend->append == NULL)
+    {
+      if (task->rank == MASTER_RANK)
+	ERRF("The %s API does not support appends", task->aio_backend->name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->open_files_per_task > 1 &&
+      ((params->workload != STANDARD &&
+	params->workload != CHECKPOINT_RESTART) ||
+       !uniform_transfers (params)))
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("Several open files per task require the STANDARD or "
+	    "CHECKPOINT_RESTART workload and a single transfer size that "
+	    "divides the block sizes");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->dirty_fraction < 1 &&
+      (params->workload != STANDARD || !params->write_test ||
+       params->use_rep_in_file_name || params->file_layout == LOG_STRUCTURED ||
+       params->max_queue_depth > 0 || params->misalignment_steps > 0))
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("Delta checkpoints require the write test of the STANDARD "
+	    "workload, the same file in all repetitions, a layout other "
+	    "than LOG_STRUCTURED and no queue depth or misalignment sweep");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->workload == SMALL_FILES &&
+      (params->file_size_distribution == UNIFORM_SIZE ||
+       params->file_size_distribution == LOGNORMAL_SIZE) &&
+      params->max_file_size < params->file_size)
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("UNIFORM and LOGNORMAL file sizes require a max_file_size not "
+	    "below file_size, which bounds the buffers of the tasks");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->workload == SMALL_FILES &&
+      params->file_size_distribution == EMPIRICAL_SIZE &&
+      params->file_size_histogram[0] == '\0')
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("EMPIRICAL file sizes require a file_size_histogram");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->workload == VISIBILITY &&
+      (params->num_tasks < 2 || task->aio_backend->sync == NULL ||
+       params->record_size < (iore_size_t) (2 * sizeof (unsigned long long))))
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("The VISIBILITY workload requires at least two tasks, an API "
+	    "with sync support and a record_size of at least 16 bytes");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if ((params->misalignment > 0 || params->misalignment_steps > 0) &&
+      (params->workload != STANDARD || params->update_test ||
+       params->max_queue_depth > 0 || params->misalignment <= 0))
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("Misaligned offsets require a misalignment, and the STANDARD "
+	    "workload without update tests or a queue depth sweep");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->drop_cache_before_read &&
+      (task->aio_backend->drop_cache == NULL ||
+       task->aio_backend->cached == NULL))
+    {
+      if (task->rank == MASTER_RANK)
+	ERRF("The %s API does not support dropping the page cache",
+	     task->aio_backend->name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (((params->durability == FSYNC ||
+	params->durability == FSYNC_INTERVAL) &&
+       task->aio_backend->sync == NULL) ||
+      ((params->durability == FDATASYNC ||
+	params->durability == SYNC_FILE_RANGE) &&
+       task->aio_backend->datasync == NULL) ||
+      (params->durability == SYNC_FILE_RANGE &&
+       task->aio_backend->writeback == NULL))
+    {
+      if (task->rank == MASTER_RANK)
+	ERRF("The %s API does not support the durability requested",
+	     task->aio_backend->name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if ((params->durability == FSYNC_INTERVAL ||
+       params->durability == SYNC_FILE_RANGE) &&
+      (params->sync_interval <= 0 || params->queue_depth > 1 ||
+       params->max_queue_depth > 0))
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("Interval durability requires a sync_interval, and transfers "
+	    "that are not queued");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if ((params->preallocation == FALLOCATE &&
+       task->aio_backend->allocate == NULL) ||
+      (params->preallocation == SPARSE_FILE &&
+       task->aio_backend->truncate == NULL) ||
+      (params->punch_holes && task->aio_backend->punch == NULL))
+    {
+      if (task->rank == MASTER_RANK)
+	ERRF("The %s API does not support the preallocation or hole punching "
+	     "requested", task->aio_backend->name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->workload == METADATA && task->aio_backend->stat == NULL)
+    {
+      if (task->rank == MASTER_RANK)
+	ERRF("The %s API does not support metadata operations",
+	     task->aio_backend->name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if ((params->queue_depth > 1 || params->max_queue_depth > 0) &&
+      task->aio_backend->submit == NULL)
+    {
+      if (task->rank == MASTER_RANK)
+	ERRF("The %s API does not support queue depths above one",
+	     task->aio_backend->name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->sharing_policy != SHARED_FILE)
+    return;
+
+  if (params->file_layout == LOG_STRUCTURED &&
+      !(uniform_transfers (params) && params->stonewall == 0))
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("The LOG_STRUCTURED layout requires a single transfer size that "
+	    "divides the block sizes, and no stonewall");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->file_layout == INTERLEAVED &&
+      !(uniform_transfers (params) && uniform_blocks (params)))
+    {
+      if (task->rank == MASTER_RANK)
+	ERR("The INTERLEAVED layout requires a single block size and a "
+	    "single transfer size that divides it");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (params->access_pattern != SEQUENTIAL &&
+      params->access_pattern != REVERSE && params->access_pattern != STRIDED &&
+      !uniform_transfers (params) &&
+      task->verbosity >= NORMAL && task->rank == MASTER_RANK)
+    WARN("Transfer sizes differ or do not divide block sizes; "
+	 "random accesses are limited to each task's region of the "
+	 "shared file");
+} /* validate_run (iore_params_t *) */
+
+/*
+ * Reset performance timers to collect results from an experiment run.
+ */ 
+static void
+setup_perf_collectors (int num_repetitions)
+{
+  int i;
+  for (i = 0; i < NUM_TIMERS; i++)
+    {
+      task->timer[i] = (iore_time_t *)
+	malloc(num_repetitions * sizeof(iore_time_t));
+      if (task->timer[i] == NULL)
+	{
+	  FATAL("Failed to setup performance timers");
+	  MPI_Abort(MPI_COMM_WORLD, -1);
+	}
+    }
+
+  for (i = 0; i < NUM_ACCESS; i++)
+    {
+      task->data_moved[i] = (iore_size_t *)
+	malloc (num_repetitions * sizeof (iore_size_t));
+      if (task->data_moved[i] == NULL)
+	{
+	  FATAL("Failed to setup data moved collector");
+	  MPI_Abort(MPI_COMM_WORLD, -1);
+	}
+    }
+} /* setup_perf_collectors (int) */
+
+/*
+ * Setup offsets and buffers for read and write tests.
+ */
+static void
+setup_io (access_t access, int r, iore_params_t *params,
+	  iore_offsets_t **offsets, void **buf)
+{
+  int pretend_rank;
+  int i;
+
+  pretend_rank = get_pretend_rank (params, access);
+
+  i = pretend_rank % params->block_sizes_length;
+  task->block_size = params->block_sizes[i];
+
+  i = pretend_rank % params->transfer_sizes_length;
+  task->transfer_size = params->transfer_sizes[i];
+
+  *offsets = new_offsets (pretend_rank, r, access, task->block_size,
+			  task->transfer_size, params);
+
+  *buf = get_buffer (access, pretend_rank, params->queue_depth);
+
+  /* after a stonewalled write, tests produce only the first wear_out_count
+     offsets of their pattern, i.e., those the write produced */
+  if (access != WRITE && task->wear_out_count >= 0)
+    limit_offsets (*offsets, task->wear_out_count, params);
+} /* setup_io (access_t, int, iore_params_t *, iore_offsets_t **, ...) */
+
+/*
+ * Deallocate the memory used for file offsets and I/O buffers.
+ */
+static void
+cleanup_io (iore_offsets_t **offsets, void **buf)
+{
+  free_offsets (*offsets);
+  free (*buf);
+
+  /* the trace is complete up to the test */
+  if (task->capture != NULL)
+    flush_capture (task->capture);
+} /* cleanup_io (iore_offsets_t **, void **) */
+
+/*
+ * Bind an abstract I/O implementation to the backend.
+ */
+static void
+bind_aio_backend (char *api)
+{
+  iore_aio_t *backend = NULL;
+  iore_aio_t **aio = available_aio;
+
+  while (*aio != NULL && backend == NULL)
+    {
+      if (STREQUAL(api, (*aio)->name))
+	backend = *aio;
+
+      aio++;
+    }
+
+  if (backend == NULL)
+    FATALF("Unrecognized abstract I/O API: %s.", api);
+  else
+    task->aio_backend = backend;
+} /* bind_aio_backend (char *) */
+
+/*
+ * Generates a data signatures to be used in write tests.
+ */
+static void
+setup_data_signature ()
+{
+  time_t curtime;
+
+  curtime = time(NULL);
+  if (curtime == -1)
+    FATAL("Failed to generate data signature.");
+
+  task->data_signature = curtime;
+} /* setup_data_signature () */
+
+/*
+ * Returns the actual file name used for tests. It may include suffixes and
+ * prefixes depending on supplied parameters.
+ */
+static char *
+get_test_file_name (iore_params_t *params, access_t access, int r)
+{
+  char *file_name = (char *) malloc(MAX_STR_LEN * sizeof(char));
+  char *tmp = (char *) malloc(MAX_STR_LEN * sizeof(char)); 
+  int pretend_rank;
+  
+  if (params->sharing_policy == SHARED_FILE)
+    strcpy (file_name, params->root_file_name);
+  else
+    { /* FILE_PER_PROCESS */
       pretend_rank = get_pretend_rank (params, access);
       
       if (params->dir_per_file)
@@ -585,225 +2354,716 @@ create_rank_dir (char *file_name, int rank)
 } /* create_rank_dir (char *, int) */
 
 /*
- * Remove the test file pointed by the task context.
+ * Remove the test file pointed by the task context, or the files a task keeps
+ * open, named after it.
  */
 static void
 remove_file (iore_params_t *params)
 {
-  if (((params->sharing_policy == SHARED_FILE && task->rank == MASTER_RANK) ||
-       params->sharing_policy == FILE_PER_PROCESS) &&
-      access (task->test_file_name, F_OK) == 0)
+  char *test_file_name = task->test_file_name;
+  int f;
+
+  if (!((params->sharing_policy == SHARED_FILE && task->rank == MASTER_RANK) ||
+	params->sharing_policy == FILE_PER_PROCESS))
+    return;
+
+  if (params->open_files_per_task == 1)
+    {
+      if (access (task->test_file_name, F_OK) == 0)
+	task->aio_backend->delete (params);
+      return;
+    }
+
+  for (f = 0; f < params->open_files_per_task; f++)
     {
-      task->aio_backend->delete (params);
+      task->test_file_name = get_open_file_name (test_file_name, f);
+      if (access (task->test_file_name, F_OK) == 0)
+	task->aio_backend->delete (params);
+      free (task->test_file_name);
     }
+
+  task->test_file_name = test_file_name;
 } /* remove_file (iore_params_t *) */
 
 /*
- * Perform data transfer requests for read and write operations.
+ * Create or open the files of a test: the test file pointed by the task
+ * context, or the open_files_per_task files named after it.
+ */
+static void **
+open_test_files (int create, iore_params_t *params)
+{
+  char *test_file_name = task->test_file_name;
+  void **fds;
+  int f;
+
+  fds = (void **) malloc (params->open_files_per_task * sizeof (void *));
+  if (fds == NULL)
+    {
+      FATAL("Failed to allocate memory for the open files");
+      MPI_Abort(MPI_COMM_WORLD, -1);
+    }
+
+  for (f = 0; f < params->open_files_per_task; f++)
+    {
+      if (params->open_files_per_task > 1)
+	task->test_file_name = get_open_file_name (test_file_name, f);
+
+      if (create)
+	fds[f] = task->aio_backend->create (params);
+      else
+	fds[f] = task->aio_backend->open (params);
+
+      if (params->open_files_per_task > 1)
+	free (task->test_file_name);
+    }
+
+  task->test_file_name = test_file_name;
+
+  return (fds);
+} /* open_test_files (int, iore_params_t *) */
+
+/*
+ * Close the files of a test.
+ */
+static void
+close_test_files (void **fds, iore_params_t *params)
+{
+  int f;
+
+  for (f = 0; f < params->open_files_per_task; f++)
+    task->aio_backend->close (fds[f], params);
+
+  free (fds);
+} /* close_test_files (void **, iore_params_t *) */
+
+/*
+ * Flush the files of a test at its end, as its durability requires.
+ */
+static void
+sync_test_files (void **fds, iore_params_t *params)
+{
+  int f;
+
+  for (f = 0; f < params->open_files_per_task; f++)
+    sync_test_file (fds[f], params);
+} /* sync_test_files (void **, iore_params_t *) */
+
+/*
+ * Flush a written file at the end of a test. FSYNC and FSYNC_INTERVAL sync the
+ * file, while FDATASYNC and SYNC_FILE_RANGE sync its data only, the latter
+ * completing the write-back started while writing. Files opened with O_DSYNC
+ * or O_SYNC are already on stable storage.
+ */
+static void
+sync_test_file (void *fd, iore_params_t *params)
+{
+  if (params->durability == FSYNC || params->durability == FSYNC_INTERVAL)
+    task->aio_backend->sync (fd, params);
+  else if (params->durability == FDATASYNC ||
+	   params->durability == SYNC_FILE_RANGE)
+    task->aio_backend->datasync (fd, params);
+} /* sync_test_file (void *, iore_params_t *) */
+
+/*
+ * Flush the files of a test every sync_interval bytes written: FSYNC_INTERVAL
+ * syncs them, and SYNC_FILE_RANGE starts their write-back without waiting for
+ * it. The time spent is added to the sync_time of the task.
+ */
+static void
+flush_test_files (void **fds, iore_params_t *params)
+{
+  iore_time_t start = current_time ();
+  int f;
+
+  for (f = 0; f < params->open_files_per_task; f++)
+    {
+      if (params->durability == FSYNC_INTERVAL)
+	task->aio_backend->sync (fds[f], params);
+      else
+	task->aio_backend->writeback (fds[f], 0, 0, params);
+    }
+
+  task->sync_time += current_time () - start;
+  task->sync_count++;
+} /* flush_test_files (void **, iore_params_t *) */
+
+/*
+ * Evict the files of a test from the page cache, and measure what remains
+ * resident once all tasks are done: the time taken by the task, and the
+ * resident bytes and size of its files. In a shared file every task evicts
+ * the whole file, as tasks may run on different nodes.
+ */
+static void
+evict_test_files (iore_time_t *time, iore_size_t *resident,
+		  iore_size_t *file_size, iore_params_t *params)
+{
+  iore_time_t start;
+  iore_size_t size;
+  void **fds;
+  int f;
+
+  fds = open_test_files (FALSE, params);
+
+  start = current_time ();
+  for (f = 0; f < params->open_files_per_task; f++)
+    task->aio_backend->drop_cache (fds[f], params);
+  *time = current_time () - start;
+
+  MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+
+  *resident = 0;
+  *file_size = 0;
+  for (f = 0; f < params->open_files_per_task; f++)
+    {
+      *resident += task->aio_backend->cached (fds[f], &size, params);
+      *file_size += size;
+    }
+
+  close_test_files (fds, params);
+} /* evict_test_files (iore_time_t *, iore_size_t *, iore_size_t *, ...) */
+
+/*
+ * Returns the name of the f-th file a task keeps open, with the index appended
+ * to the test file name.
+ */
+static char *
+get_open_file_name (char *test_file_name, int f)
+{
+  size_t size = MAXPATHLEN + 16; /* room for the suffix */
+  char *file_name = (char *) malloc (size * sizeof (char));
+
+  snprintf (file_name, size, "%s.%d", test_file_name, f);
+
+  return (file_name);
+} /* get_open_file_name (char *, int) */
+
+/*
+ * Returns the name of a file of a workload with several files, such as the
+ * files of a replayed trace or the shards of a dataset.
+ */
+static char *
+get_workload_file_name (iore_params_t *params, iore_size_t f, int r)
+{
+  size_t size = MAXPATHLEN + 32; /* room for the suffixes */
+  char *file_name = (char *) malloc (size * sizeof (char));
+
+  if (params->use_rep_in_file_name)
+    snprintf (file_name, size, "%s.%lld.%d", params->root_file_name, f, r);
+  else
+    snprintf (file_name, size, "%s.%lld", params->root_file_name, f);
+
+  return (file_name);
+} /* get_workload_file_name (iore_params_t *, iore_size_t, int) */
+
+/*
+ * Remove the files of a workload with several files, spread over the tasks.
+ */
+static void
+remove_workload_files (iore_params_t *params, int r)
+{
+  char *test_file_name = task->test_file_name;
+  iore_size_t f;
+
+  for (f = task->rank; f < task->num_files; f += params->num_tasks)
+    {
+      task->test_file_name = get_workload_file_name (params, f, r);
+      if (access (task->test_file_name, F_OK) == 0)
+	task->aio_backend->delete (params);
+      free (task->test_file_name);
+    }
+
+  task->test_file_name = test_file_name;
+} /* remove_workload_files (iore_params_t *, int) */
+
+/*
+ * Perform data transfer requests for read and write operations. In mixed
+ * tests, the operation of the n-th transfer is drawn from a stream of the
+ * repetition reserved to them, and the latency of each operation is recorded.
+ *
+ * In open loop tests, the n-th transfer is issued at its arrival time, or as
+ * soon as possible if late, and its latency is measured from the arrival time,
+ * so the time waiting behind slower transfers is not omitted.
+ *
+ * With a queue depth above one, up to queue_depth transfers are kept in flight
+ * through the asynchronous interface of the backend, and completed in the
+ * order they were submitted.
+ *
+ * With a stonewall, a task stops issuing transfers once the time limit
+ * expires, and then goes on up to the largest number of transfers done by any
+ * task (wear-out), so all tasks end with the same amount of data accessed.
+ *
+ * With several open files, each transfer goes to the file its slot is spread
+ * to, at its offset in that file.
  */
 static iore_size_t
-perform_io (void *fd, access_t access, iore_offset_t *offsets, iore_size_t *buf,
-	    iore_params_t *params)
+perform_io (void **fds, access_t access, int r, iore_offsets_t *offsets,
+	    iore_size_t *buf, iore_params_t *params)
 {
-  iore_size_t remaining = task->block_size;
-  iore_size_t transferred = 0;
   iore_size_t data_moved = 0;
+  iore_offset_t offset;
   iore_size_t size;
-  int i = 0;
+  unsigned long long stream;
+  unsigned long long n = 0;
+  iore_size_t *op_buf = buf;
+  access_t op = access;
+  iore_time_t start = 0;
+  iore_time_t io_start;
+  iore_size_t count = 0;
+  iore_size_t limit = -1;
+  iore_time_t arrival = 0;
+  unsigned long long arrival_stream;
+  unsigned long long update_stream;
+  double rate = 0;
+  int open_loop = (params->arrival_process != CLOSED_LOOP);
+  iore_samples_t *samples;
+  int depth = params->queue_depth;
+  iore_size_t xfer_words = task->transfer_size / sizeof (iore_size_t);
+  iore_size_t pending = 0;
+  iore_queue_t *queue = NULL;
+  int slot = 0;
+  iore_trace_record_t rec;
+  char *window = NULL;
+  iore_size_t file_size;
+  void *fd;
+  iore_size_t unsynced = 0;
+  int interval_sync = (params->durability == FSYNC_INTERVAL ||
+		       params->durability == SYNC_FILE_RANGE);
+
+  stream = (1ULL << 63) | ((unsigned long long) r << 32) |
+    (unsigned long long) task->rank;
+  arrival_stream = (1ULL << 62) | ((unsigned long long) r << 32) |
+    (unsigned long long) task->rank;
+  update_stream = (1ULL << 56) | ((unsigned long long) r << 32) |
+    (unsigned long long) task->rank;
+
+  /* the offered load is split evenly among tasks */
+  if (params->target_iops > 0)
+    rate = params->target_iops / params->num_tasks;
+  else if (params->target_bandwidth > 0)
+    rate = ((double) params->target_bandwidth / params->num_tasks) /
+      task->transfer_size;
+
+  /* updates are synchronous, with a window holding a transfer and its
+     partial blocks */
+  if (access == UPDATE)
+    {
+      depth = 1;
+      task->update_moved = 0;
+      window = (char *) malloc (task->transfer_size +
+				(2 * params->fs_block_size));
+      if (window == NULL)
+	{
+	  FATAL("Failed to allocate memory for the update window");
+	  MPI_Abort(MPI_COMM_WORLD, -1);
+	}
+    }
 
-  while (offsets[i] != -1)
+  if (depth > 1)
     {
-      if (task->verbosity >= DEBUG)
+      queue = (iore_queue_t *) malloc (depth * sizeof (iore_queue_t));
+      if (queue == NULL)
+	{
+	  FATAL("Failed to allocate memory for the transfers in flight");
+	  MPI_Abort(MPI_COMM_WORLD, -1);
+	}
+    }
+
+  samples = &task->samples[access];
+  reset_hist (&samples->latency[READ]);
+  reset_hist (&samples->latency[WRITE]);
+  samples->moved[READ] = 0;
+  samples->moved[WRITE] = 0;
+  samples->transfers = 0;
+  samples->straddles[0] = 0;
+  samples->straddles[1] = 0;
+
+  /* latencies are sampled when they are reported */
+  if (!(access == MIXED || open_loop || params->max_queue_depth > 0 ||
+	params->misalignment_steps > 0))
+    samples = NULL;
+
+  task->stonewall_time = -1;
+  task->sync_time = 0;
+  task->sync_count = 0;
+  memset (&rec, 0, sizeof (rec));
+
+  io_start = current_time ();
+  task->phase = access;
+  task->phase_start = io_start;
+  while ((limit < 0 || count < limit) &&
+	 next_offset (offsets, &offset, &size))
+    {
+      slot = count % depth;
+
+      /* reads use a transfer of the buffer after the written pattern, so it
+	 is not overwritten */
+      if (access == MIXED)
 	{
-	  if (access == WRITE)
-	    INFOF("Task %d writing to offset %lld\n", task->rank, offsets[i]);
+	  if (rand_double (params->random_seed, stream, n++) <
+	      params->read_fraction)
+	    {
+	      op = READ;
+	      op_buf = buf + ((1 + slot) * xfer_words);
+	    }
 	  else
-	    INFOF("Task %d reading from offset %lld\n", task->rank, offsets[i]);
+	    {
+	      op = WRITE;
+	      op_buf = buf;
+	    }
+	}
+      else if (access == READ)
+	{
+	  op_buf = buf + (slot * xfer_words);
+	}
+      else if (access == UPDATE)
+	{
+	  op = WRITE;
+	}
+
+      if (open_loop)
+	{
+	  arrival = get_arrival (arrival, count, rate, arrival_stream, params);
+	  start = io_start + arrival;
+	  wait_until (start);
+	}
+      else if (samples != NULL || task->capture != NULL)
+	{
+	  start = current_time ();
+	}
+
+      fd = fds[0];
+      file_size = offsets->file_size;
+      if (offsets->num_files > 1)
+	{
+	  rec.file = spread_offset (offsets, &offset, &file_size);
+	  fd = fds[rec.file];
 	}
 
-      size = task->transfer_size >= remaining ? remaining : task->transfer_size;
+      /* shifted transfers, or records updated in them, and their
+	 alignment */
+      offset += params->misalignment;
+      if (access == UPDATE)
+	place_update (&offset, &size, update_stream, count, params);
+      task->samples[access].transfers++;
+      if (straddles_boundary (offset, size, params->fs_block_size))
+	task->samples[access].straddles[0]++;
+      if (straddles_boundary (offset, size, params->stripe_size))
+	task->samples[access].straddles[1]++;
+
+      rec.op = op;
+      rec.offset = offset;
+      rec.length = size;
+      rec.start = start;
 
-      transferred = task->aio_backend->io (fd, buf, size, offsets[i], access,
-					   params);
-      if (transferred != size)
+      if (task->verbosity >= DEBUG)
 	{
-	  if (access == WRITE)
-	    FATAL("Failed to write to file");
+	  if (op == WRITE)
+	    INFOF("Task %d writing to offset %lld\n", task->rank, offset);
 	  else
-	    FATAL("Failed to read from file");
+	    INFOF("Task %d reading from offset %lld\n", task->rank, offset);
+	}
 
-	  MPI_Abort(MPI_COMM_WORLD, -1);
+      if (depth > 1)
+	{
+	  /* the slot is free once its previous transfer completes */
+	  if (pending == depth)
+	    {
+	      data_moved += complete_io (&queue[slot], samples, params);
+	      pending--;
+	    }
+
+	  queue[slot].rec = rec;
+	  queue[slot].request = task->aio_backend->submit (fd, op_buf, size,
+							   offset, op, params);
+	  pending++;
+	}
+      else if (access == UPDATE)
+	{
+	  rec.result = update_io (fd, op_buf, window, offset, size, file_size,
+				  params);
+	  data_moved += check_io (&rec, samples);
 	}
       else
 	{
-	  remaining -= size;
-	  data_moved += transferred;
-	  i++;
+	  rec.result = task->aio_backend->io (fd, op_buf, size, offset, op,
+					      params);
+	  data_moved += check_io (&rec, samples);
 	}
+
+      if (interval_sync && op == WRITE)
+	{
+	  unsynced += size;
+	  if (unsynced >= params->sync_interval)
+	    {
+	      flush_test_files (fds, params);
+	      unsynced = 0;
+	    }
+	}
+
+      count++;
+      if (params->stonewall > 0 && limit < 0 &&
+	  current_time () - io_start >= params->stonewall)
+	limit = wear_out (count, data_moved, current_time () - io_start);
+    }
+
+  /* complete the transfers still in flight, oldest first */
+  for (; pending > 0; pending--)
+    data_moved += complete_io (&queue[(count - pending) % depth],
+			       samples, params);
+  free (queue);
+  free (window);
+
+  /* tasks done before the stonewall still agree on the wear-out */
+  if (params->stonewall > 0 && limit < 0)
+    limit = wear_out (count, data_moved, current_time () - io_start);
+
+  if (access == WRITE && limit >= 0)
+    task->wear_out_count = limit;
+
+  if (offsets->file_layout == LOG_STRUCTURED)
+    {
+      task->counter_time = offsets->counter_time;
+      task->counter_count = count;
     }
 
   return (data_moved);
-} /* perform_io (void *, access_t, iore_offset_t *, iore_size_t *, ...) */
+} /* perform_io (void **, access_t, int, iore_offsets_t *, iore_size_t *, ...) */
 
 /*
- * Sleep for n seconds.
+ * Wait for a transfer in flight to complete, and account for it.
+ */
+static iore_size_t
+complete_io (iore_queue_t *entry, iore_samples_t *samples,
+	     iore_params_t *params)
+{
+  entry->rec.result = task->aio_backend->wait (entry->request, params);
+
+  return (check_io (&entry->rec, samples));
+} /* complete_io (iore_queue_t *, iore_samples_t *, iore_params_t *) */
+
+/*
+ * Place the record updated in the slot of a transfer: update_size bytes, or a
+ * random length if zero, at a random offset in the slot. Records therefore
+ * start and end off the fs_block_size boundaries even when transfers are
+ * aligned to them.
  */
 static void
-delay_secs (int n)
+place_update (iore_offset_t *offset, iore_size_t *size,
+	      unsigned long long stream, iore_size_t n, iore_params_t *params)
 {
-  if (task->rank == MASTER_RANK && n > 0)
-    {
-      if (task->verbosity >= VERBOSE)
-	INFOF("Delaying for %d seconds...\n", n);
+  iore_size_t length = params->update_size;
 
-      sleep (n);
-    }
-} /* delay_secs (int) */
+  if (length > *size)
+    length = *size;
+  else if (length == 0)
+    length = 1 + rand_u64 (params->random_seed, stream, 2 * n) % *size;
+
+  *offset += rand_u64 (params->random_seed, stream, 2 * n + 1) %
+    (*size - length + 1);
+  *size = length;
+} /* place_update (iore_offset_t *, iore_size_t *, unsigned long long, ...) */
 
 /*
- * Returns an array of sequential offsets.
+ * Update a record of a file in place: read the fs_block_size aligned window
+ * covering it, up to the end of the file, copy the record into the window
+ * and write the window back. Returns the length of the record, or -1 on a
+ * short transfer; the bytes read and written are added to the update_moved
+ * of the task.
  */
-static iore_offset_t *
-get_sequential_offsets (int rank, iore_params_t *params)
+static iore_size_t
+update_io (void *fd, iore_size_t *buf, char *window, iore_offset_t offset,
+	   iore_size_t length, iore_size_t file_size, iore_params_t *params)
 {
-  iore_offset_t *offsets;
-  iore_offset_t first = 0;
-  int n, i, q, r;
+  iore_size_t block = params->fs_block_size;
+  iore_offset_t first = (offset / block) * block;
+  iore_offset_t last = ((offset + length + block - 1) / block) * block;
+  iore_size_t moved;
 
-  /* count the number of offsets */
-  if (task->block_size % task->transfer_size == 0)
-    n = task->block_size / task->transfer_size;
-  else
-    n = (task->block_size / task->transfer_size) + 1;
+  if (last > file_size)
+    last = file_size;
 
-  /* setup empty array of offsets */
-  offsets = (iore_offset_t *) malloc ((n + 1) * sizeof(iore_offset_t));
-  if (offsets == NULL)
-    FATAL("Failed to setup the array of offsets");
+  moved = task->aio_backend->io (fd, (iore_size_t *) window, last - first,
+				 first, READ, params);
+  if (moved != last - first)
+    return (-1);
 
-  /* mark the end of the offsets */
-  offsets[n] = -1;
+  memcpy (window + (offset - first), buf, length);
+
+  moved = task->aio_backend->io (fd, (iore_size_t *) window, last - first,
+				 first, WRITE, params);
+  if (moved != last - first)
+    return (-1);
+
+  task->update_moved += 2 * (last - first);
+
+  return (length);
+} /* update_io (void *, iore_size_t *, char *, iore_offset_t, ...) */
+
+/*
+ * Check that a transfer is complete, record its latency from its start time if
+ * the test is sampled, and capture it if traced. Returns the amount of data
+ * moved.
+ */
+static iore_size_t
+check_io (iore_trace_record_t *rec, iore_samples_t *samples)
+{
+  iore_time_t end;
 
-  /* fill with file offsets */
-  if (params->sharing_policy == FILE_PER_PROCESS)
+  if (rec->result != rec->length)
     {
-      for (i = 0; i < n; i++)
-	offsets[i] = i * task->transfer_size;
+      if (rec->op == WRITE)
+	FATAL("Failed to write to file");
+      else
+	FATAL("Failed to read from file");
+
+      MPI_Abort(MPI_COMM_WORLD, -1);
     }
-  else /* SHARED_FILE */
-    {
-      /* compute the first offset of the rank; q is the integer number of loops
-	 over all block sizes */
-      q = rank / params->block_sizes_length;
-      if (q > 0)
-	{
-	  for (i = 0; i < params->block_sizes_length; i++)
-	    first += params->block_sizes[i];
 
-	  first *= q;
-	}
-      /* r is the remainder loops over block sizes */
-      r = rank % params->block_sizes_length;
-      for (i = 0; i < r; i++)
-	first += params->block_sizes[i];
+  if (samples == NULL && task->capture == NULL)
+    return (rec->result);
+
+  end = current_time ();
+
+  if (samples != NULL)
+    {
+      hist_add (&samples->latency[rec->op], end - rec->start);
+      samples->moved[rec->op] += rec->result;
+    }
 
-      /* fill with file offsets */
-      for (i = 0; i < n; i++)
-	offsets[i] = first + (i * task->transfer_size);
+  /* traced times are relative to the start of the phase */
+  if (task->capture != NULL)
+    {
+      rec->rank = task->rank;
+      rec->phase = task->phase;
+      rec->start -= task->phase_start;
+      rec->end = end - task->phase_start;
+      capture_record (task->capture, rec);
     }
-  
-  return (offsets);
-} /* get_sequential_offsets (int, iore_params_t *) */
+
+  return (rec->result);
+} /* check_io (iore_trace_record_t *, iore_samples_t *) */
 
 /*
- * Returns an array of random offsets.
+ * Record the progress of a task at the stonewall, and returns the largest
+ * number of transfers done by any task.
  */
-static iore_offset_t *
-get_random_offsets (int rank, iore_params_t *params)
+static iore_size_t
+wear_out (iore_size_t count, iore_size_t data_moved, iore_time_t elapsed)
 {
-  iore_offset_t *offsets;
-  iore_offset_t o;
-  iore_size_t *remaining;
-  iore_size_t file_size = 0;
-  iore_size_t transfer_size = 0;
-  int n, i, j;
+  iore_size_t max_count;
 
-  /* count the number of offsets */
-  if (task->block_size % task->transfer_size == 0)
-    n = task->block_size / task->transfer_size;
-  else
-    n = (task->block_size / task->transfer_size) + 1;
+  task->stonewall_time = elapsed;
+  task->stonewall_moved = data_moved;
+  task->stonewall_count = count;
 
-  /* setup empty array of offsets */
-  offsets = (iore_offset_t *) malloc ((n + 1) * sizeof(iore_offset_t));
-  if (offsets == NULL)
-    FATAL("Failed to setup the array of offsets");
+  MPI_TRYCATCH(MPI_Allreduce (&count, &max_count, 1, MPI_LONG_LONG_INT,
+			      MPI_MAX, task->comm),
+	       "Failed to agree on the wear-out point");
 
-  /* mark the end of the offsets */
-  offsets[n] = -1;
+  return (max_count);
+} /* wear_out (iore_size_t, iore_size_t, iore_time_t) */
 
-  /* fill with file offsets */
-  if (params->sharing_policy == FILE_PER_PROCESS)
+/*
+ * Returns the arrival time of the n-th transfer of a task, relative to the
+ * start of the test, from the arrival time of the previous one. Transfers
+ * arrive at a fixed rate, with exponential gaps drawn from the task's arrival
+ * stream (POISSON), or in groups of burst_size at a fixed rate of groups.
+ */
+static iore_time_t
+get_arrival (iore_time_t previous, iore_size_t n, double rate,
+	     unsigned long long stream, iore_params_t *params)
+{
+  switch (params->arrival_process)
     {
-      for (i = 0; i < n; i++)
-	offsets[i] = i * task->transfer_size;
+    case FIXED_RATE:
+      return (n / rate);
+    case POISSON:
+      return (previous - log1p (-rand_double (params->random_seed, stream, n))
+	      / rate);
+    default: /* BURSTY */
+      return ((n / params->burst_size) * (params->burst_size / rate));
     }
-  else /* SHARED_FILE */
+} /* get_arrival (iore_time_t, iore_size_t, double, unsigned long long, ...) */
+
+/*
+ * Wait until a given time. Long waits sleep, and the last hundred microseconds
+ * are spent polling the clock for precision.
+ */
+static void
+wait_until (iore_time_t t)
+{
+  struct timespec ts;
+  iore_time_t remaining;
+
+  while ((remaining = t - current_time ()) > 0)
     {
-      /* array to guarantee all tasks have their portion of the file */
-      remaining = (iore_size_t *) malloc (params->num_tasks *
-					  sizeof (iore_size_t));
-      for (i = 0; i < params->num_tasks; i++)
+      if (remaining > 2e-4)
 	{
-	  remaining[i] = params->block_sizes[i % params->block_sizes_length];
-	  file_size += remaining[i];
+	  remaining -= 1e-4;
+	  ts.tv_sec = (time_t) remaining;
+	  ts.tv_nsec = (long) ((remaining - ts.tv_sec) * 1e9);
+	  nanosleep (&ts, NULL);
 	}
+    }
+} /* wait_until (iore_time_t) */
 
-      j = 0;
-      for (o = 0; remaining[rank] > 0 && o < file_size; o += transfer_size)
-	{
-	  do
-	    i = random () % params->num_tasks;
-	  while (remaining[i] == 0);
+/*
+ * Check whether the time limit of a run has expired. The master task decides
+ * and broadcasts it, so all tasks leave a loop of collective steps together.
+ */
+static int
+deadline_reached (iore_time_t deadline, iore_params_t *params)
+{
+  int reached = FALSE;
 
-	  if (i == rank)
-	    offsets[j++] = 0;
+  if (params->run_time_limit == 0)
+    return (FALSE);
 
-	  transfer_size =
-	    params->transfer_sizes[i % params->transfer_sizes_length];
-	  transfer_size = (transfer_size >= remaining[i] ?
-			   remaining[i] : transfer_size);
-	  remaining[i] -= transfer_size;
-	}
-    }
+  if (task->rank == MASTER_RANK)
+    reached = (current_time () >= deadline);
+  MPI_TRYCATCH(MPI_Bcast (&reached, 1, MPI_INT, MASTER_RANK, task->comm),
+	       "Failed to broadcast the deadline");
+
+  return (reached);
+} /* deadline_reached (iore_time_t, iore_params_t *) */
 
-  /* shuffle offsets */
-  for (i = 0; i < n; i++)
+/*
+ * Sleep for n seconds.
+ */
+static void
+delay_secs (int n)
+{
+  if (task->rank == MASTER_RANK && n > 0)
     {
-      j = random () % n;
-      o = offsets[j];
-      offsets[j] = offsets[i];
-      offsets[i] = o;
-    }
+      if (task->verbosity >= VERBOSE)
+	INFOF("Delaying for %d seconds...\n", n);
 
-  return (offsets);
-} /* get_random_offsets (int, iore_params_t *) */
+      sleep (n);
+    }
+} /* delay_secs (int) */
 
 /*
- * Setup the buffer for read and write tests.
+ * Setup the buffer for read and write tests. Transfers in flight share the
+ * written pattern, but each read has its own transfer of the buffer.
  */
 static void *
-get_buffer (access_t access, int rank)
+get_buffer (access_t access, int rank, int queue_depth)
 {
   unsigned long long *buf;
   unsigned long long even, odd;
   size_t i;
   
-  buf = malloc (task->transfer_size);
+  /* mixed tests hold the written pattern and the read data apart */
+  if (access == MIXED)
+    buf = malloc ((1 + queue_depth) * task->transfer_size);
+  else if (access == READ)
+    buf = malloc (queue_depth * task->transfer_size);
+  else
+    buf = malloc (task->transfer_size);
   if (buf == NULL)
     FATAL("Failed to allocate memory for the I/O buffer");
 
-  if (access == WRITE)
+  if (access != READ)
     {
       /* fill buffer */
       even = (unsigned long long) rank;
@@ -814,7 +3074,7 @@ get_buffer (access_t access, int rank)
     }
 
   return (buf);
-} /* get_buffer (access_t, int) */
+} /* get_buffer (access_t, int, int) */
 
 /*
  * Returns an alternative rank for read tests, so a task can read a file not in
@@ -825,7 +3085,7 @@ get_pretend_rank (iore_params_t *params, access_t access)
 {
   int pretend_rank;
 
-  if (access == WRITE || !params->reorder_tasks)
+  if (access != READ || !params->reorder_tasks)
     pretend_rank = task->rank;
   else /* READ and reorder_tasks */
     pretend_rank =
@@ -1,8 +1,15 @@
+#define _GNU_SOURCE /* fallocate, sync_file_range */
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <aio.h>
+#include <dirent.h>
+#include <string.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <mpi.h>
 
 #include "iore_aio.h"
@@ -21,8 +28,24 @@
 #define open64 open /* unlike, but may pose */
 #endif
 
-#ifndef lseek64
-#define lseek64 lseek /* unlike, but my pose */
+#ifndef pread64
+#define pread64 pread
+#endif
+
+#ifndef pwrite64
+#define pwrite64 pwrite
+#endif
+
+#ifdef FALLOC_FL_PUNCH_HOLE
+#define POSIX_PUNCH posix_punch
+#else
+#define POSIX_PUNCH NULL /* no hole punching on this system */
+#endif
+
+#ifdef SYNC_FILE_RANGE_WRITE
+#define POSIX_WRITEBACK posix_writeback
+#else
+#define POSIX_WRITEBACK NULL /* no write-back control on this system */
 #endif
 
 /******************************************************************************
@@ -35,13 +58,42 @@ static void posix_close (void *, iore_params_t *);
 static void posix_delete (iore_params_t *);
 static iore_size_t posix_io (void *, iore_size_t *, iore_size_t, iore_offset_t,
 			     access_t, iore_params_t *);
+static void *posix_submit (void *, iore_size_t *, iore_size_t, iore_offset_t,
+			   access_t, iore_params_t *);
+static iore_size_t posix_wait (void *, iore_params_t *);
+static void *posix_open_append (iore_params_t *);
+static iore_size_t posix_append (void *, iore_size_t *, iore_size_t,
+				 iore_params_t *);
+static void posix_allocate (void *, iore_offset_t, iore_size_t,
+			    iore_params_t *);
+static void posix_truncate (void *, iore_size_t, iore_params_t *);
+#ifdef FALLOC_FL_PUNCH_HOLE
+static void posix_punch (void *, iore_offset_t, iore_size_t, iore_params_t *);
+#endif
+static void posix_sync (void *, iore_params_t *);
+static void posix_datasync (void *, iore_params_t *);
+static void posix_drop_cache (void *, iore_params_t *);
+static iore_size_t posix_cached (void *, iore_size_t *, iore_params_t *);
+#ifdef SYNC_FILE_RANGE_WRITE
+static void posix_writeback (void *, iore_offset_t, iore_size_t,
+			     iore_params_t *);
+#endif
+static int posix_stat (char *, iore_params_t *);
+static int posix_mkdir (char *, iore_params_t *);
+static int posix_rmdir (char *, iore_params_t *);
+static int posix_rename (char *, char *, iore_params_t *);
+static iore_size_t posix_readdir (char *, iore_params_t *);
 
 /******************************************************************************
  * D E C L A R A T I O N S
  ******************************************************************************/
 
 iore_aio_t iore_aio_posix =
-  { "POSIX", posix_create, posix_open, posix_close, posix_delete, posix_io };
+  { "POSIX", posix_create, posix_open, posix_close, posix_delete, posix_io,
+    posix_submit, posix_wait, posix_open_append, posix_append, posix_allocate,
+    posix_truncate, POSIX_PUNCH, posix_sync, posix_datasync, POSIX_WRITEBACK,
+    posix_drop_cache, posix_cached, posix_stat, posix_mkdir, posix_rmdir,
+    posix_rename, posix_readdir };
 
 /*****************************************************************************
  * G L O B A L S
@@ -60,6 +112,11 @@ posix_create (iore_params_t *params)
   int oflag = O_BINARY | O_CREAT | O_RDWR;
   mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
 
+  if (params->durability == DSYNC_OPEN)
+    oflag |= O_DSYNC;
+  else if (params->durability == SYNC_OPEN)
+    oflag |= O_SYNC;
+
   fd = (int *) malloc (sizeof(int));
   if (fd == NULL)
     FATAL("Failed to allocate memory to file descriptor");
@@ -77,6 +134,11 @@ posix_open (iore_params_t *params)
   int *fd;
   int oflag = O_BINARY | O_RDWR;
 
+  if (params->durability == DSYNC_OPEN)
+    oflag |= O_DSYNC;
+  else if (params->durability == SYNC_OPEN)
+    oflag |= O_SYNC;
+
   fd = (int *) malloc (sizeof(int));
   if (fd == NULL)
     FATAL("Failed to allocate memory to file descriptor");
@@ -114,17 +176,13 @@ posix_io (void *file, iore_size_t *buffer, iore_size_t length,
   int retries = 0;
   iore_size_t n;
 
-  if (lseek64 (fd, offset, SEEK_SET) == -1)
-    {
-      FATAL("Failed seeking file offset");
-      MPI_Abort (MPI_COMM_WORLD, -1);
-    }
-
+  /* positioned transfers keep no file offset state, so threads can share
+     the file descriptor */
   while (remaining > 0)
     {
       if (access == WRITE)
 	{
-	  n = write (fd, buf, remaining);
+	  n = pwrite64 (fd, buf, remaining, offset + length - remaining);
 	  if (n == -1)
 	    {
 	      FATAL("Failed to write to file");
@@ -133,7 +191,7 @@ posix_io (void *file, iore_size_t *buffer, iore_size_t length,
 	}
       else /* READ */
 	{
-	  n = read (fd, buf, remaining);
+	  n = pread64 (fd, buf, remaining, offset + length - remaining);
 	  if (n == 0)
 	    {
 	      FATAL("read() returned EOF prematurely");
@@ -172,3 +230,374 @@ posix_io (void *file, iore_size_t *buffer, iore_size_t length,
   
   return (length);
 } /* posix_io (void *, iore_size_t *, iore_size_t, iore_offset_t, ... *) */
+
+/*
+ * Start an asynchronous transfer with POSIX AIO. Returns the control block of
+ * the request, to be completed by posix_wait.
+ */
+static void *
+posix_submit (void *file, iore_size_t *buffer, iore_size_t length,
+	      iore_offset_t offset, access_t access, iore_params_t *params)
+{
+  struct aiocb *cb;
+  int rc;
+
+  (void) params;
+
+  cb = (struct aiocb *) calloc (1, sizeof (struct aiocb));
+  if (cb == NULL)
+    {
+      FATAL("Failed to allocate memory for the asynchronous request");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  cb->aio_fildes = *(int *) file;
+  cb->aio_buf = buffer;
+  cb->aio_nbytes = length;
+  cb->aio_offset = offset;
+  cb->aio_lio_opcode = (access == WRITE) ? LIO_WRITE : LIO_READ;
+
+  if (access == WRITE)
+    rc = aio_write (cb);
+  else /* READ */
+    rc = aio_read (cb);
+
+  if (rc != 0)
+    {
+      FATAL("Failed to submit an asynchronous transfer");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  return ((void *) cb);
+} /* posix_submit (void *, iore_size_t *, iore_size_t, iore_offset_t, ...) */
+
+/*
+ * Wait for an asynchronous transfer to complete. A partial transfer is
+ * completed synchronously, with the same retry policy as posix_io.
+ */
+static iore_size_t
+posix_wait (void *request, iore_params_t *params)
+{
+  struct aiocb *cb = (struct aiocb *) request;
+  const struct aiocb *list[1] = { cb };
+  iore_size_t length = cb->aio_nbytes;
+  iore_size_t n;
+  int fd;
+  access_t access;
+
+  while (aio_error (cb) == EINPROGRESS)
+    aio_suspend (list, 1, NULL);
+
+  n = aio_return (cb);
+  if (n == -1)
+    {
+      FATAL("Asynchronous transfer failed");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (n < length)
+    {
+      if (params->single_io_attempt)
+	{
+	  FATAL("Single I/O attempt option defined; aborting");
+	  MPI_Abort (MPI_COMM_WORLD, -1);
+	}
+
+      fd = cb->aio_fildes;
+      access = cb->aio_lio_opcode == LIO_WRITE ? WRITE : READ;
+      posix_io (&fd, (iore_size_t *) ((char *) cb->aio_buf + n), length - n,
+		cb->aio_offset + n, access, params);
+    }
+
+  free (cb);
+
+  return (length);
+} /* posix_wait (void *, iore_params_t *) */
+
+/*
+ * Open or create a file in append mode: every write goes to the end of the
+ * file, atomically with respect to the other appenders of the file.
+ */
+static void *
+posix_open_append (iore_params_t *params)
+{
+  int *fd;
+  int oflag = O_BINARY | O_CREAT | O_WRONLY | O_APPEND;
+  mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+
+  (void) params;
+
+  fd = (int *) malloc (sizeof(int));
+  if (fd == NULL)
+    FATAL("Failed to allocate memory to file descriptor");
+
+  *fd = open64 (task->test_file_name, oflag, mode);
+  if (*fd < 0)
+    FATAL("Could not open the test file for appending");
+
+  return ((void *) fd);
+} /* posix_open_append (iore_params_t *) */
+
+/*
+ * Append a record to a file opened by posix_open_append. The rest of a
+ * partial write is appended separately, so it may not be contiguous with the
+ * beginning of the record.
+ */
+static iore_size_t
+posix_append (void *file, iore_size_t *buffer, iore_size_t length,
+	      iore_params_t *params)
+{
+  iore_size_t remaining = length;
+  char *buf = (char *) buffer;
+  int fd = *(int *) file;
+  iore_size_t n;
+
+  while (remaining > 0)
+    {
+      n = write (fd, buf, remaining);
+      if (n == -1)
+	{
+	  FATAL("Failed to append to file");
+	  MPI_Abort (MPI_COMM_WORLD, -1);
+	}
+
+      if (n < remaining)
+	{
+	  WARNF("Task %d partially appended %lld of %lld bytes", task->rank,
+		n, remaining);
+
+	  if (params->single_io_attempt)
+	    {
+	      FATAL("Single I/O attempt option defined; aborting");
+	      MPI_Abort (MPI_COMM_WORLD, -1);
+	    }
+	}
+
+      remaining -= n;
+      buf += n;
+    }
+
+  return (length);
+} /* posix_append (void *, iore_size_t *, iore_size_t, iore_params_t *) */
+
+/*
+ * Reserve the blocks of a range of a file. posix_fallocate falls back to
+ * writing zeros on file systems that cannot reserve blocks.
+ */
+static void
+posix_allocate (void *fd, iore_offset_t offset, iore_size_t length,
+		iore_params_t *params)
+{
+  int error;
+
+  (void) params;
+
+  error = posix_fallocate (*(int *) fd, offset, length);
+  if (error != 0)
+    {
+      errno = error;
+      FATAL("Failed to preallocate the test file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+} /* posix_allocate (void *, iore_offset_t, iore_size_t, iore_params_t *) */
+
+static void
+posix_truncate (void *fd, iore_size_t size, iore_params_t *params)
+{
+  (void) params;
+
+  if (ftruncate (*(int *) fd, size) != 0)
+    {
+      FATAL("Failed to set the size of the test file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+} /* posix_truncate (void *, iore_size_t, iore_params_t *) */
+
+#ifdef FALLOC_FL_PUNCH_HOLE
+static void
+posix_punch (void *fd, iore_offset_t offset, iore_size_t length,
+	     iore_params_t *params)
+{
+  (void) params;
+
+  if (fallocate (*(int *) fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+		 offset, length) != 0)
+    {
+      FATAL("Failed to punch a hole in the test file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+} /* posix_punch (void *, iore_offset_t, iore_size_t, iore_params_t *) */
+#endif
+
+static void
+posix_sync (void *fd, iore_params_t *params)
+{
+  (void) params;
+
+  if (fsync (*(int *) fd) != 0)
+    {
+      FATAL("Failed to sync the test file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+} /* posix_sync (void *, iore_params_t *) */
+
+static void
+posix_datasync (void *fd, iore_params_t *params)
+{
+  (void) params;
+
+  if (fdatasync (*(int *) fd) != 0)
+    {
+      FATAL("Failed to sync the data of the test file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+} /* posix_datasync (void *, iore_params_t *) */
+
+#ifdef SYNC_FILE_RANGE_WRITE
+static void
+posix_writeback (void *fd, iore_offset_t offset, iore_size_t length,
+		 iore_params_t *params)
+{
+  (void) params;
+
+  if (sync_file_range (*(int *) fd, offset, length,
+		       SYNC_FILE_RANGE_WRITE) != 0)
+    {
+      FATAL("Failed to start the write-back of the test file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+} /* posix_writeback (void *, iore_offset_t, iore_size_t, iore_params_t *) */
+#endif
+
+/*
+ * Evict a file from the page cache. Dirty pages are not evicted, so the file
+ * is synced first; the kernel may still keep pages mapped by other processes.
+ */
+static void
+posix_drop_cache (void *fd, iore_params_t *params)
+{
+  int error;
+
+  posix_sync (fd, params);
+
+  error = posix_fadvise (*(int *) fd, 0, 0, POSIX_FADV_DONTNEED);
+  if (error != 0)
+    {
+      errno = error;
+      FATAL("Failed to evict the test file from the page cache");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+} /* posix_drop_cache (void *, iore_params_t *) */
+
+/*
+ * Count the pages of a file resident in the page cache, mapping the file to
+ * query them with mincore.
+ */
+static iore_size_t
+posix_cached (void *fd, iore_size_t *size, iore_params_t *params)
+{
+  struct stat st;
+  long page_size = sysconf (_SC_PAGESIZE);
+  size_t num_pages;
+  unsigned char *vec;
+  void *map;
+  iore_size_t resident = 0;
+  size_t i;
+
+  (void) params;
+
+  if (fstat (*(int *) fd, &st) != 0)
+    {
+      FATAL("Failed to get the size of the test file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  *size = st.st_size;
+  if (st.st_size == 0)
+    return (0);
+
+  num_pages = (st.st_size + page_size - 1) / page_size;
+  vec = (unsigned char *) malloc (num_pages);
+  map = mmap (NULL, st.st_size, PROT_READ, MAP_SHARED, *(int *) fd, 0);
+  if (vec == NULL || map == MAP_FAILED)
+    {
+      FATAL("Failed to map the test file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (mincore (map, st.st_size, vec) != 0)
+    {
+      FATAL("Failed to query the page cache residency of the test file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  for (i = 0; i < num_pages; i++)
+    if (vec[i] & 1)
+      resident += page_size;
+
+  munmap (map, st.st_size);
+  free (vec);
+
+  /* the last page may be partial */
+  return ((resident > *size) ? *size : resident);
+} /* posix_cached (void *, iore_size_t *, iore_params_t *) */
+
+static int
+posix_stat (char *path, iore_params_t *params)
+{
+  struct stat st;
+
+  (void) params;
+
+  return (stat (path, &st));
+} /* posix_stat (char *, iore_params_t *) */
+
+static int
+posix_mkdir (char *path, iore_params_t *params)
+{
+  (void) params;
+
+  return (mkdir (path, S_IRWXU));
+} /* posix_mkdir (char *, iore_params_t *) */
+
+static int
+posix_rmdir (char *path, iore_params_t *params)
+{
+  (void) params;
+
+  return (rmdir (path));
+} /* posix_rmdir (char *, iore_params_t *) */
+
+static int
+posix_rename (char *old_path, char *new_path, iore_params_t *params)
+{
+  (void) params;
+
+  return (rename (old_path, new_path));
+} /* posix_rename (char *, char *, iore_params_t *) */
+
+/*
+ * List all entries of a directory, as a file system browser would, and
+ * returns their number, not counting "." and "..".
+ */
+static iore_size_t
+posix_readdir (char *path, iore_params_t *params)
+{
+  struct dirent *entry;
+  iore_size_t count = 0;
+  DIR *dir;
+
+  (void) params;
+
+  dir = opendir (path);
+  if (dir == NULL)
+    return (-1);
+
+  while ((entry = readdir (dir)) != NULL)
+    if (strcmp (entry->d_name, ".") != 0 && strcmp (entry->d_name, "..") != 0)
+      count++;
+
+  closedir (dir);
+
+  return (count);
+} /* posix_readdir (char *, iore_params_t *) */
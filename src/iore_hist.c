@@ -0,0 +1,187 @@
+#include <string.h>
+#include <mpi.h>
+
+#include "iore_hist.h"
+#include "util.h"
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+static int get_bucket (unsigned long long);
+static unsigned long long get_bucket_value (int);
+
+/******************************************************************************
+ * F U N C T I O N S
+ ******************************************************************************/
+
+/*
+ * Remove all samples of a histogram.
+ */
+void
+reset_hist (iore_hist_t *hist)
+{
+  memset (hist->count, 0, sizeof (hist->count));
+  hist->total = 0;
+  hist->sum = 0;
+  hist->min = 0;
+  hist->max = 0;
+} /* reset_hist (iore_hist_t *) */
+
+/*
+ * Add a latency sample, in seconds, to a histogram. The memory used is fixed,
+ * whatever the number of samples.
+ */
+void
+hist_add (iore_hist_t *hist, iore_time_t latency)
+{
+  unsigned long long ns;
+
+  if (latency < 0)
+    latency = 0;
+
+  ns = (unsigned long long) (latency * 1e9);
+  hist->count[get_bucket (ns)]++;
+
+  if (hist->total == 0 || latency < hist->min)
+    hist->min = latency;
+  if (hist->total == 0 || latency > hist->max)
+    hist->max = latency;
+
+  hist->total++;
+  hist->sum += latency;
+} /* hist_add (iore_hist_t *, iore_time_t) */
+
+/*
+ * Add all samples of a histogram to another.
+ */
+void
+merge_hist (iore_hist_t *hist, iore_hist_t *merged)
+{
+  int i;
+
+  if (hist->total == 0)
+    return;
+
+  for (i = 0; i < HIST_NUM_BUCKETS; i++)
+    merged->count[i] += hist->count[i];
+
+  if (merged->total == 0 || hist->min < merged->min)
+    merged->min = hist->min;
+  if (merged->total == 0 || hist->max > merged->max)
+    merged->max = hist->max;
+
+  merged->total += hist->total;
+  merged->sum += hist->sum;
+} /* merge_hist (iore_hist_t *, iore_hist_t *) */
+
+/*
+ * Merge the histograms of all tasks in a communicator into the master rank.
+ * Tasks without samples do not affect the minimum and maximum.
+ */
+void
+reduce_hist (iore_hist_t *hist, iore_hist_t *merged, MPI_Comm comm)
+{
+  iore_time_t min = hist->total > 0 ? hist->min : 1e300;
+
+  MPI_TRYCATCH(MPI_Reduce (hist->count, merged->count, HIST_NUM_BUCKETS,
+			   MPI_LONG_LONG_INT, MPI_SUM, MASTER_RANK, comm),
+	       "Failed to merge latency histograms");
+  MPI_TRYCATCH(MPI_Reduce (&hist->total, &merged->total, 1, MPI_LONG_LONG_INT,
+			   MPI_SUM, MASTER_RANK, comm),
+	       "Failed to merge latency histograms");
+  MPI_TRYCATCH(MPI_Reduce (&hist->sum, &merged->sum, 1, MPI_DOUBLE, MPI_SUM,
+			   MASTER_RANK, comm),
+	       "Failed to merge latency histograms");
+  MPI_TRYCATCH(MPI_Reduce (&min, &merged->min, 1, MPI_DOUBLE, MPI_MIN,
+			   MASTER_RANK, comm),
+	       "Failed to merge latency histograms");
+  MPI_TRYCATCH(MPI_Reduce (&hist->max, &merged->max, 1, MPI_DOUBLE, MPI_MAX,
+			   MASTER_RANK, comm),
+	       "Failed to merge latency histograms");
+} /* reduce_hist (iore_hist_t *, iore_hist_t *, MPI_Comm) */
+
+/*
+ * Returns the latency, in seconds, at a percentile (from 0 to 100) of a
+ * histogram. The value is the middle of the bucket holding the percentile,
+ * bounded by the smallest and largest samples.
+ */
+iore_time_t
+hist_percentile (iore_hist_t *hist, double percentile)
+{
+  long long rank;
+  long long seen = 0;
+  iore_time_t value;
+  int i;
+
+  if (hist->total == 0)
+    return (0);
+
+  rank = (long long) ((percentile / 100.0) * hist->total);
+  if (rank >= hist->total)
+    rank = hist->total - 1;
+
+  for (i = 0; i < HIST_NUM_BUCKETS - 1; i++)
+    {
+      seen += hist->count[i];
+      if (seen > rank)
+	break;
+    }
+
+  value = ((get_bucket_value (i) + get_bucket_value (i + 1)) / 2) / 1e9;
+  if (value < hist->min)
+    value = hist->min;
+  if (value > hist->max)
+    value = hist->max;
+
+  return (value);
+} /* hist_percentile (iore_hist_t *, double) */
+
+/*
+ * Returns the mean latency, in seconds, of a histogram.
+ */
+iore_time_t
+hist_mean (iore_hist_t *hist)
+{
+  return (hist->total > 0 ? hist->sum / hist->total : 0);
+} /* hist_mean (iore_hist_t *) */
+
+/*
+ * Returns the bucket of a value in nanoseconds. Values below 2^HIST_SUB_BITS
+ * have a bucket each; above it, each power of two is split in 2^HIST_SUB_BITS
+ * buckets.
+ */
+static int
+get_bucket (unsigned long long ns)
+{
+  int msb;
+
+  if (ns < (1ULL << HIST_SUB_BITS))
+    return ((int) ns);
+
+  msb = 63 - __builtin_clzll (ns);
+  if (msb > HIST_MAX_BITS)
+    return (HIST_NUM_BUCKETS - 1);
+
+  return (((msb - HIST_SUB_BITS + 1) << HIST_SUB_BITS) +
+	  (int) ((ns >> (msb - HIST_SUB_BITS)) &
+		 ((1ULL << HIST_SUB_BITS) - 1)));
+} /* get_bucket (unsigned long long) */
+
+/*
+ * Returns the smallest value in nanoseconds of a bucket.
+ */
+static unsigned long long
+get_bucket_value (int bucket)
+{
+  int msb;
+
+  if (bucket < (1 << HIST_SUB_BITS))
+    return ((unsigned long long) bucket);
+
+  msb = (bucket >> HIST_SUB_BITS) + HIST_SUB_BITS - 1;
+
+  return ((1ULL << msb) +
+	  ((unsigned long long) (bucket & ((1 << HIST_SUB_BITS) - 1)) <<
+	   (msb - HIST_SUB_BITS)));
+} /* get_bucket_value (int) */
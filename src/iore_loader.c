@@ -0,0 +1,304 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "iore_loader.h"
+#include "util.h"
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+static void *prefetch_samples (void *);
+
+/******************************************************************************
+ * F U N C T I O N S
+ ******************************************************************************/
+
+/*
+ * Create a dataset of samples_per_shard samples in each of num_shards shards.
+ * Sample sizes are either fixed, when max_size is not above min_size, or
+ * uniformly distributed in [min_size, max_size], drawn from a stream of the
+ * generator so that all tasks compute the same dataset. Sizes are drawn again
+ * when needed, and only the offsets of variable size samples are kept, so a
+ * dataset of fixed size samples takes constant memory.
+ */
+iore_dataset_t *
+new_dataset (int num_shards, iore_size_t samples_per_shard,
+	     iore_size_t min_size, iore_size_t max_size,
+	     unsigned long long key, unsigned long long stream)
+{
+  iore_dataset_t *dataset;
+  iore_offset_t offset = 0;
+  iore_size_t size;
+  iore_size_t i;
+
+  dataset = (iore_dataset_t *) malloc (sizeof (iore_dataset_t));
+  if (dataset == NULL)
+    {
+      FATAL("Failed to allocate memory for the dataset");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  dataset->num_shards = num_shards;
+  dataset->samples_per_shard = samples_per_shard;
+  dataset->num_samples = num_shards * samples_per_shard;
+  dataset->min_size = min_size;
+  dataset->size_range = (max_size > min_size) ? max_size - min_size + 1 : 1;
+  dataset->key = key;
+  dataset->stream = stream;
+  dataset->offsets = NULL;
+  dataset->max_size = min_size;
+
+  if (dataset->size_range == 1)
+    return (dataset);
+
+  dataset->offsets = (iore_offset_t *)
+    malloc (dataset->num_samples * sizeof (iore_offset_t));
+  if (dataset->offsets == NULL)
+    {
+      FATAL("Failed to allocate memory for the dataset");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  for (i = 0; i < dataset->num_samples; i++)
+    {
+      if (i % samples_per_shard == 0)
+	offset = 0;
+
+      size = sample_size (dataset, i);
+      dataset->offsets[i] = offset;
+      offset += size;
+
+      if (size > dataset->max_size)
+	dataset->max_size = size;
+    }
+
+  return (dataset);
+} /* new_dataset (int, iore_size_t, iore_size_t, iore_size_t, ...) */
+
+/*
+ * Release a dataset.
+ */
+void
+free_dataset (iore_dataset_t *dataset)
+{
+  free (dataset->offsets);
+  free (dataset);
+} /* free_dataset (iore_dataset_t *) */
+
+/*
+ * Returns the offset of a sample in its shard.
+ */
+iore_offset_t
+sample_offset (iore_dataset_t *dataset, iore_size_t sample)
+{
+  if (dataset->offsets == NULL)
+    return ((sample % dataset->samples_per_shard) * dataset->min_size);
+
+  return (dataset->offsets[sample]);
+} /* sample_offset (iore_dataset_t *, iore_size_t) */
+
+/*
+ * Returns the size of a sample.
+ */
+iore_size_t
+sample_size (iore_dataset_t *dataset, iore_size_t sample)
+{
+  if (dataset->size_range == 1)
+    return (dataset->min_size);
+
+  return (dataset->min_size + rand_u64 (dataset->key, dataset->stream, sample)
+	  % dataset->size_range);
+} /* sample_size (iore_dataset_t *, iore_size_t) */
+
+/*
+ * Start num_threads threads prefetching the samples at positions [first,
+ * last) of a shuffled order into a queue of depth buffers. Shards are read
+ * through their open files, so the io function of the backend must be thread
+ * safe, and MPI must support MPI_THREAD_MULTIPLE, as it aborts on errors from
+ * the threads.
+ */
+iore_prefetch_t *
+new_prefetch (iore_dataset_t *dataset, void **fds, iore_perm_t *perm,
+	      iore_size_t first, iore_size_t last, int num_threads, int depth,
+	      iore_aio_t *backend, iore_params_t *params)
+{
+  iore_prefetch_t *prefetch;
+  int i;
+
+  prefetch = (iore_prefetch_t *) malloc (sizeof (iore_prefetch_t));
+  if (prefetch != NULL)
+    {
+      prefetch->buffers = (char **) calloc (depth, sizeof (char *));
+      prefetch->free_slots = (int *) malloc (depth * sizeof (int));
+      prefetch->ready = (iore_fetched_t *)
+	malloc (depth * sizeof (iore_fetched_t));
+      prefetch->threads = (pthread_t *)
+	malloc (num_threads * sizeof (pthread_t));
+    }
+  if (prefetch == NULL || prefetch->buffers == NULL ||
+      prefetch->free_slots == NULL || prefetch->ready == NULL ||
+      prefetch->threads == NULL)
+    {
+      FATAL("Failed to allocate memory for the prefetch threads");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  for (i = 0; i < depth; i++)
+    {
+      prefetch->buffers[i] = (char *) malloc (dataset->max_size);
+      if (prefetch->buffers[i] == NULL)
+	{
+	  FATAL("Failed to allocate memory for the prefetch buffers");
+	  MPI_Abort (MPI_COMM_WORLD, -1);
+	}
+      prefetch->free_slots[i] = i;
+    }
+
+  prefetch->dataset = dataset;
+  prefetch->fds = fds;
+  prefetch->backend = backend;
+  prefetch->params = params;
+  prefetch->perm = *perm;
+  prefetch->next = first;
+  prefetch->last = last;
+  prefetch->depth = depth;
+  prefetch->num_free = depth;
+  prefetch->head = 0;
+  prefetch->count = 0;
+  prefetch->num_threads = num_threads;
+  prefetch->num_done = 0;
+  pthread_mutex_init (&prefetch->lock, NULL);
+  pthread_cond_init (&prefetch->not_full, NULL);
+  pthread_cond_init (&prefetch->not_empty, NULL);
+
+  for (i = 0; i < num_threads; i++)
+    if (pthread_create (&prefetch->threads[i], NULL, prefetch_samples,
+			prefetch) != 0)
+      {
+	FATAL("Failed to start a prefetch thread");
+	MPI_Abort (MPI_COMM_WORLD, -1);
+      }
+
+  return (prefetch);
+} /* new_prefetch (iore_dataset_t *, void **, iore_perm_t *, ...) */
+
+/*
+ * Wait for the next sample in the queue, in the order the samples were read.
+ * Returns FALSE when all samples of the epoch were consumed.
+ */
+int
+next_sample (iore_prefetch_t *prefetch, iore_fetched_t *fetched)
+{
+  pthread_mutex_lock (&prefetch->lock);
+  while (prefetch->count == 0 &&
+	 prefetch->num_done < prefetch->num_threads)
+    pthread_cond_wait (&prefetch->not_empty, &prefetch->lock);
+
+  if (prefetch->count == 0)
+    {
+      pthread_mutex_unlock (&prefetch->lock);
+      return (FALSE);
+    }
+
+  *fetched = prefetch->ready[prefetch->head];
+  prefetch->head = (prefetch->head + 1) % prefetch->depth;
+  prefetch->count--;
+  pthread_mutex_unlock (&prefetch->lock);
+
+  return (TRUE);
+} /* next_sample (iore_prefetch_t *, iore_fetched_t *) */
+
+/*
+ * Release the buffer of a consumed sample.
+ */
+void
+release_sample (iore_prefetch_t *prefetch, iore_fetched_t *fetched)
+{
+  pthread_mutex_lock (&prefetch->lock);
+  prefetch->free_slots[prefetch->num_free++] = fetched->slot;
+  pthread_cond_signal (&prefetch->not_full);
+  pthread_mutex_unlock (&prefetch->lock);
+} /* release_sample (iore_prefetch_t *, iore_fetched_t *) */
+
+/*
+ * Join the prefetch threads and release the pool. All samples must have been
+ * consumed.
+ */
+void
+close_prefetch (iore_prefetch_t *prefetch)
+{
+  int i;
+
+  for (i = 0; i < prefetch->num_threads; i++)
+    pthread_join (prefetch->threads[i], NULL);
+
+  for (i = 0; i < prefetch->depth; i++)
+    free (prefetch->buffers[i]);
+
+  pthread_mutex_destroy (&prefetch->lock);
+  pthread_cond_destroy (&prefetch->not_full);
+  pthread_cond_destroy (&prefetch->not_empty);
+  free (prefetch->buffers);
+  free (prefetch->free_slots);
+  free (prefetch->ready);
+  free (prefetch->threads);
+  free (prefetch);
+} /* close_prefetch (iore_prefetch_t *) */
+
+/*
+ * Body of the prefetch threads: claim a position and a free buffer, read the
+ * sample at that position of the shuffled order and queue it, until the
+ * positions of the task are exhausted.
+ */
+static void *
+prefetch_samples (void *arg)
+{
+  iore_prefetch_t *prefetch = (iore_prefetch_t *) arg;
+  iore_dataset_t *dataset = prefetch->dataset;
+  iore_fetched_t fetched;
+  iore_size_t position;
+  iore_size_t shard;
+  iore_time_t start;
+
+  for (;;)
+    {
+      pthread_mutex_lock (&prefetch->lock);
+      while (prefetch->num_free == 0 && prefetch->next < prefetch->last)
+	pthread_cond_wait (&prefetch->not_full, &prefetch->lock);
+
+      if (prefetch->next >= prefetch->last)
+	break;
+
+      position = prefetch->next++;
+      fetched.slot = prefetch->free_slots[--prefetch->num_free];
+      pthread_mutex_unlock (&prefetch->lock);
+
+      fetched.sample = permute (&prefetch->perm, position);
+      shard = fetched.sample / dataset->samples_per_shard;
+
+      start = current_time ();
+      fetched.moved = prefetch->backend->io
+	(prefetch->fds[shard],
+	 (iore_size_t *) prefetch->buffers[fetched.slot],
+	 sample_size (dataset, fetched.sample),
+	 sample_offset (dataset, fetched.sample), READ, prefetch->params);
+      fetched.latency = current_time () - start;
+
+      pthread_mutex_lock (&prefetch->lock);
+      prefetch->ready[(prefetch->head + prefetch->count) % prefetch->depth] =
+	fetched;
+      prefetch->count++;
+      pthread_cond_signal (&prefetch->not_empty);
+      pthread_mutex_unlock (&prefetch->lock);
+    }
+
+  /* wake up the consumer and the other threads waiting for buffers */
+  prefetch->num_done++;
+  pthread_cond_broadcast (&prefetch->not_empty);
+  pthread_cond_broadcast (&prefetch->not_full);
+  pthread_mutex_unlock (&prefetch->lock);
+
+  return (NULL);
+} /* prefetch_samples (void *) */
@@ -0,0 +1,620 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mpi.h>
+
+#include "iore_offsets.h"
+#include "iore_params.h"
+#include "iore_rand.h"
+#include "iore_task.h"
+#include "util.h"
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+static iore_size_t stride (iore_offsets_t *, iore_size_t);
+static iore_size_t sample (iore_offsets_t *);
+static void place (iore_offsets_t *, iore_size_t, iore_offset_t *,
+		   iore_size_t *);
+static void setup_sampling (iore_offsets_t *, iore_params_t *);
+static iore_offset_t get_first_offset (int, iore_params_t *);
+static int next_extent (iore_offsets_t *, iore_offset_t *, iore_size_t *);
+static void setup_dirty (iore_offsets_t *, int, int, iore_params_t *);
+
+/******************************************************************************
+ * G L O B A L S
+ ******************************************************************************/
+
+extern iore_task_t *task;
+
+/******************************************************************************
+ * F U N C T I O N S
+ ******************************************************************************/
+
+/*
+ * Create an offset generator for a task in a test. Offsets are computed on
+ * demand, so the memory used does not depend on the number of transfers.
+ *
+ * A task accesses segment_count blocks. In a file per process, and in the
+ * CONTIGUOUS layout of a shared file, they are a single region of the file.
+ * In the SEGMENTED layout, each segment of the shared file holds one block
+ * of every task. In the INTERLEAVED layout, tasks take turns at transfer
+ * granularity, i.e., task i accesses every num_tasks-th transfer.
+ *
+ * Skewed patterns (ZIPFIAN, HOTSPOT and GAUSSIAN) sample the slots with
+ * replacement, with the hottest slots at the start of the sampled space. The
+ * space is the whole shared file if split in uniform transfers, or the
+ * task's own transfers otherwise. Write tests populate the file
+ * sequentially, so that every sampled offset can be read back.
+ *
+ * REVERSE and STRIDED patterns visit every transfer of the task once, either
+ * backwards or every access_stride-th transfer, wrapping around to the next
+ * unvisited one until all are accessed.
+ *
+ * With a dirty_fraction below one, write tests after the first repetition are
+ * delta checkpoints: they skip the transfers whose slot is not dirty, so only
+ * that fraction of the slots, single or in runs of dirty_cluster_size, is
+ * rewritten, in the order of the access pattern.
+ *
+ * LOG_STRUCTURED writes ignore the access pattern: each transfer takes the
+ * next free slot of the whole shared file from a counter in an RMA window of
+ * the master rank, so creating the generator is collective. Other tests on a
+ * LOG_STRUCTURED file access it as CONTIGUOUS, which covers the same slots.
+ */
+iore_offsets_t *
+new_offsets (int rank, int r, access_t access, iore_size_t block_size,
+	     iore_size_t transfer_size, iore_params_t *params)
+{
+  iore_offsets_t *offsets;
+  iore_size_t file_size;
+  unsigned long long stream;
+
+  offsets = (iore_offsets_t *) malloc (sizeof (iore_offsets_t));
+  if (offsets == NULL)
+    {
+      FATAL("Failed to allocate memory for the offset generator");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  offsets->access_pattern = params->access_pattern;
+  if (access == WRITE && (params->access_pattern == ZIPFIAN ||
+			  params->access_pattern == HOTSPOT ||
+			  params->access_pattern == GAUSSIAN))
+    offsets->access_pattern = SEQUENTIAL;
+
+  offsets->rank = rank;
+  offsets->num_tasks = params->num_tasks;
+  offsets->transfer_size = transfer_size;
+  offsets->next = 0;
+  offsets->produced = 0;
+  offsets->stride = params->access_stride;
+  offsets->global = FALSE;
+  offsets->base = 0;
+  offsets->dirty_runs = -1;
+
+  if (params->sharing_policy == FILE_PER_PROCESS ||
+      (params->file_layout == LOG_STRUCTURED && access != WRITE))
+    offsets->file_layout = CONTIGUOUS;
+  else /* SHARED_FILE */
+    offsets->file_layout = params->file_layout;
+
+  if (params->sharing_policy == FILE_PER_PROCESS)
+    offsets->file_size = block_size * params->segment_count;
+  else
+    offsets->file_size = get_first_offset (params->num_tasks, params) *
+      params->segment_count;
+
+  /* the assignment of slots to files is the same in all tests */
+  offsets->num_files = params->open_files_per_task;
+  offsets->file_selection = params->open_file_selection;
+  if (offsets->num_files > 1 && offsets->file_selection == RANDOM_FILES)
+    setup_perm (&offsets->file_perm, params->random_seed, 1ULL << 57,
+		offsets->file_size / transfer_size);
+
+  if (offsets->file_layout == LOG_STRUCTURED)
+    {
+      offsets->count = offsets->file_size / transfer_size;
+      offsets->limit = offsets->count;
+      offsets->counter_time = 0;
+
+      MPI_TRYCATCH(MPI_Win_allocate ((task->rank == MASTER_RANK ?
+				      sizeof (long long) : 0),
+				     sizeof (long long), MPI_INFO_NULL,
+				     task->comm, &offsets->counter,
+				     &offsets->win),
+		   "Failed to create the extent counter");
+      if (task->rank == MASTER_RANK)
+	*offsets->counter = 0;
+
+      MPI_TRYCATCH(MPI_Barrier (task->comm), "Failed syncing tasks");
+      MPI_TRYCATCH(MPI_Win_lock_all (0, offsets->win),
+		   "Failed to lock the extent counter");
+
+      return (offsets);
+    }
+
+  /* a contiguous region is handled as a single large segment */
+  if (offsets->file_layout == CONTIGUOUS)
+    {
+      offsets->block_size = block_size * params->segment_count;
+      offsets->segment_size = 0;
+    }
+  else
+    {
+      offsets->block_size = block_size;
+      offsets->segment_size = get_first_offset (params->num_tasks, params);
+    }
+
+  /* count the number of offsets */
+  if (offsets->block_size % transfer_size == 0)
+    offsets->per_segment = offsets->block_size / transfer_size;
+  else
+    offsets->per_segment = (offsets->block_size / transfer_size) + 1;
+
+  offsets->count = offsets->per_segment;
+  if (offsets->file_layout != CONTIGUOUS)
+    offsets->count *= params->segment_count;
+  offsets->limit = offsets->count;
+
+  if (params->sharing_policy == FILE_PER_PROCESS)
+    offsets->first = 0;
+  else if (offsets->file_layout == CONTIGUOUS)
+    offsets->first = get_first_offset (rank, params) * params->segment_count;
+  else /* SEGMENTED or INTERLEAVED */
+    offsets->first = get_first_offset (rank, params);
+
+  if (offsets->access_pattern == RANDOM)
+    {
+      /* in a shared file split in uniform transfers, all tasks compute the
+	 same permutation of the file's transfer slots (stream 0 of the
+	 repetition), and each task takes as many slots as its transfers;
+	 the placement of the slots makes the file layout irrelevant */
+      offsets->global = (params->sharing_policy == SHARED_FILE &&
+			 uniform_transfers (params));
+
+      stream = (unsigned long long) r << 32;
+      if (offsets->global)
+	{
+	  file_size = get_first_offset (params->num_tasks, params) *
+	    params->segment_count;
+	  offsets->base = (get_first_offset (rank, params) *
+			   params->segment_count) / transfer_size;
+	  setup_perm (&offsets->perm, params->random_seed, stream,
+		      file_size / transfer_size);
+	}
+      else
+	{
+	  stream |= (unsigned long long) (rank + 1);
+	  setup_perm (&offsets->perm, params->random_seed, stream,
+		      offsets->count);
+	}
+    }
+  else if (offsets->access_pattern == ZIPFIAN ||
+	   offsets->access_pattern == HOTSPOT ||
+	   offsets->access_pattern == GAUSSIAN)
+    {
+      offsets->global = (params->sharing_policy == SHARED_FILE &&
+			 uniform_transfers (params));
+
+      offsets->key = params->random_seed;
+      offsets->stream = ((unsigned long long) r << 32) |
+	(unsigned long long) (rank + 1);
+      if (offsets->global)
+	offsets->space = (get_first_offset (params->num_tasks, params) *
+			  params->segment_count) / transfer_size;
+      else
+	offsets->space = offsets->count;
+
+      setup_sampling (offsets, params);
+    }
+
+  if (access == WRITE && r > 0 && params->dirty_fraction < 1)
+    setup_dirty (offsets, rank, r, params);
+
+  return (offsets);
+} /* new_offsets (int, int, access_t, iore_size_t, iore_size_t, ...) */
+
+/*
+ * Release an offset generator. In LOG_STRUCTURED writes, all tasks must call
+ * it to free the window of the counter.
+ */
+void
+free_offsets (iore_offsets_t *offsets)
+{
+  if (offsets->file_layout == LOG_STRUCTURED)
+    {
+      MPI_TRYCATCH(MPI_Win_unlock_all (offsets->win),
+		   "Failed to unlock the extent counter");
+      MPI_TRYCATCH(MPI_Win_free (&offsets->win),
+		   "Failed to free the extent counter");
+    }
+
+  free (offsets);
+} /* free_offsets (iore_offsets_t *) */
+
+/*
+ * Get the offset and length of the next transfer. Returns FALSE when all
+ * transfers were generated, TRUE otherwise.
+ */
+int
+next_offset (iore_offsets_t *offsets, iore_offset_t *offset,
+	     iore_size_t *length)
+{
+  iore_size_t i;
+
+  if (offsets->produced >= offsets->limit)
+    return (FALSE);
+
+  if (offsets->file_layout == LOG_STRUCTURED)
+    {
+      if (offsets->next >= offsets->count ||
+	  !next_extent (offsets, offset, length))
+	return (FALSE);
+
+      offsets->produced++;
+      return (TRUE);
+    }
+
+  /* delta writes skip the clean slots */
+  do
+    {
+      if (offsets->next >= offsets->count)
+	return (FALSE);
+
+      if (offsets->access_pattern == SEQUENTIAL)
+	i = offsets->next;
+      else if (offsets->access_pattern == REVERSE)
+	i = offsets->count - 1 - offsets->next;
+      else if (offsets->access_pattern == STRIDED)
+	i = stride (offsets, offsets->next);
+      else if (offsets->access_pattern == RANDOM)
+	i = permute (&offsets->perm, offsets->base + offsets->next);
+      else /* skewed */
+	i = sample (offsets);
+
+      offsets->next++;
+    }
+  while (offsets->dirty_runs >= 0 &&
+	 permute (&offsets->dirty_perm, i / offsets->dirty_run) >=
+	 offsets->dirty_runs);
+
+  /* slots over all tasks are always full transfers */
+  if (offsets->global)
+    {
+      *offset = i * offsets->transfer_size;
+      *length = offsets->transfer_size;
+    }
+  else
+    place (offsets, i, offset, length);
+
+  offsets->produced++;
+  return (TRUE);
+} /* next_offset (iore_offsets_t *, iore_offset_t *, iore_size_t *) */
+
+/*
+ * Move a transfer of the file to one of the num_files open files. Slot j of
+ * the file, in transfer units, becomes slot p = j (ROUND_ROBIN_FILES) or a
+ * permutation of j (RANDOM_FILES) of the spread, which is slot p / num_files
+ * of file p % num_files, so the files are packed and each holds about
+ * 1/num_files of the data. Rewrites the offset, sets the size of the file
+ * populated by write tests and returns its index. Requires uniform transfers.
+ */
+int
+spread_offset (iore_offsets_t *offsets, iore_offset_t *offset,
+	       iore_size_t *file_size)
+{
+  iore_size_t p = *offset / offsets->transfer_size;
+  int f;
+
+  if (offsets->file_selection == RANDOM_FILES)
+    p = permute (&offsets->file_perm, p);
+
+  f = p % offsets->num_files;
+  *offset = (p / offsets->num_files) * offsets->transfer_size;
+  *file_size = get_spread_file_size (offsets, f);
+
+  return (f);
+} /* spread_offset (iore_offsets_t *, iore_offset_t *, iore_size_t *) */
+
+/*
+ * Returns the size of the f-th open file populated by write tests: the file
+ * size with a single open file, or the transfers of the slots spread to it.
+ */
+iore_size_t
+get_spread_file_size (iore_offsets_t *offsets, int f)
+{
+  iore_size_t num_slots = offsets->file_size / offsets->transfer_size;
+
+  if (offsets->num_files == 1)
+    return (offsets->file_size);
+
+  return (((num_slots - f + offsets->num_files - 1) / offsets->num_files) *
+	  offsets->transfer_size);
+} /* get_spread_file_size (iore_offsets_t *, int) */
+
+/*
+ * Limit the generator to the first transfers of the task, e.g., to those
+ * written before a stonewall. The ordering still spans all count transfers, so
+ * the first offsets produced are those of the same pattern unlimited, which a
+ * write with that pattern produced. Skewed patterns, written sequentially,
+ * sample the first limit slots of the task's own transfers instead, since the
+ * first transfers of all tasks are not contiguous in the shared file.
+ */
+void
+limit_offsets (iore_offsets_t *offsets, iore_size_t limit,
+	       iore_params_t *params)
+{
+  if (limit >= offsets->count)
+    return;
+
+  offsets->limit = limit;
+
+  if (offsets->access_pattern == ZIPFIAN ||
+      offsets->access_pattern == HOTSPOT ||
+      offsets->access_pattern == GAUSSIAN)
+    {
+      offsets->count = limit;
+      offsets->global = FALSE;
+      offsets->space = limit;
+      setup_sampling (offsets, params);
+    }
+} /* limit_offsets (iore_offsets_t *, iore_size_t, iore_params_t *) */
+
+/*
+ * Check if all tasks split a shared file in transfers of the same size, i.e.,
+ * there is a single transfer size and every block size is a multiple of it.
+ */
+int
+uniform_transfers (iore_params_t *params)
+{
+  int i;
+
+  for (i = 1; i < params->transfer_sizes_length; i++)
+    if (params->transfer_sizes[i] != params->transfer_sizes[0])
+      return (FALSE);
+
+  for (i = 0; i < params->block_sizes_length; i++)
+    if (params->block_sizes[i] % params->transfer_sizes[0] != 0)
+      return (FALSE);
+
+  return (TRUE);
+} /* uniform_transfers (iore_params_t *) */
+
+/*
+ * Check if all tasks access blocks of the same size.
+ */
+int
+uniform_blocks (iore_params_t *params)
+{
+  int i;
+
+  for (i = 1; i < params->block_sizes_length; i++)
+    if (params->block_sizes[i] != params->block_sizes[0])
+      return (FALSE);
+
+  return (TRUE);
+} /* uniform_blocks (iore_params_t *) */
+
+/*
+ * Check if a transfer crosses a boundary of units of a size with one of its
+ * ends inside a unit, so it shares that unit with the neighbouring transfers.
+ * Transfers covering whole units, or inside a single unit, do not straddle.
+ */
+int
+straddles_boundary (iore_offset_t offset, iore_size_t length, iore_size_t unit)
+{
+  iore_offset_t end = offset + length;
+
+  return ((offset / unit) != ((end - 1) / unit) &&
+	  ((offset % unit) != 0 || (end % unit) != 0));
+} /* straddles_boundary (iore_offset_t, iore_size_t, iore_size_t) */
+
+/*
+ * Setup the dirty slots of a delta write: the slots (those of the whole file
+ * when random slots span all tasks, or the task's own otherwise) are grouped
+ * in runs, and a random dirty_fraction of the runs, different at each
+ * repetition, is dirty.
+ */
+static void
+setup_dirty (iore_offsets_t *offsets, int rank, int r, iore_params_t *params)
+{
+  unsigned long long stream;
+  iore_size_t num_slots, num_runs;
+
+  stream = (1ULL << 59) | ((unsigned long long) r << 32);
+  if (offsets->global)
+    num_slots = offsets->file_size / offsets->transfer_size;
+  else
+    {
+      stream |= (unsigned long long) (rank + 1);
+      num_slots = offsets->count;
+    }
+
+  offsets->dirty_run = (params->dirty_selection == CLUSTERED) ?
+    params->dirty_cluster_size : 1;
+  num_runs = (num_slots + offsets->dirty_run - 1) / offsets->dirty_run;
+  offsets->dirty_runs = (iore_size_t) ((params->dirty_fraction * num_runs) +
+				       0.5);
+
+  setup_perm (&offsets->dirty_perm, params->random_seed, stream, num_runs);
+} /* setup_dirty (iore_offsets_t *, int, int, iore_params_t *) */
+
+/*
+ * Take the next free slot of the shared file with an atomic fetch-and-add on
+ * the counter of the master rank. Returns FALSE once the file is full.
+ */
+static int
+next_extent (iore_offsets_t *offsets, iore_offset_t *offset,
+	     iore_size_t *length)
+{
+  long long one = 1;
+  long long slot;
+  iore_time_t start = current_time ();
+
+  MPI_TRYCATCH(MPI_Fetch_and_op (&one, &slot, MPI_LONG_LONG, MASTER_RANK, 0,
+				 MPI_SUM, offsets->win),
+	       "Failed to allocate an extent");
+  MPI_TRYCATCH(MPI_Win_flush (MASTER_RANK, offsets->win),
+	       "Failed to allocate an extent");
+  offsets->counter_time += current_time () - start;
+
+  if (slot >= (long long) offsets->count)
+    return (FALSE);
+
+  *offset = slot * offsets->transfer_size;
+  *length = offsets->transfer_size;
+  offsets->next++;
+
+  return (TRUE);
+} /* next_extent (iore_offsets_t *, iore_offset_t *, iore_size_t *) */
+
+/*
+ * Returns the n-th transfer of a strided traversal: transfers congruent to 0
+ * modulo the stride first, then those congruent to 1, and so on. With q full
+ * passes and r remainder transfers, the first r residues have q + 1 elements.
+ */
+static iore_size_t
+stride (iore_offsets_t *offsets, iore_size_t n)
+{
+  iore_size_t k = offsets->stride;
+  iore_size_t q = offsets->count / k;
+  iore_size_t r = offsets->count % k;
+  iore_size_t residue, j;
+
+  if (n < r * (q + 1))
+    {
+      residue = n / (q + 1);
+      j = n % (q + 1);
+    }
+  else
+    {
+      n -= r * (q + 1);
+      residue = r + (n / q);
+      j = n % q;
+    }
+
+  return (residue + (j * k));
+} /* stride (iore_offsets_t *, iore_size_t) */
+
+/*
+ * Draw the slot of the next transfer from a skewed distribution. The draw of
+ * the n-th transfer uses the counters from n << 16 of the task's stream.
+ */
+static iore_size_t
+sample (iore_offsets_t *offsets)
+{
+  unsigned long long counter = (unsigned long long) offsets->next << 16;
+  iore_size_t cold_size;
+  iore_size_t i;
+  double center;
+  double u;
+
+  switch (offsets->access_pattern)
+    {
+    case ZIPFIAN:
+      i = rand_zipf (&offsets->zipf, offsets->key, offsets->stream,
+		     counter) - 1;
+      break;
+    case HOTSPOT:
+      cold_size = offsets->space - offsets->hot_size;
+      u = rand_double (offsets->key, offsets->stream, counter);
+      if (cold_size == 0 || u < offsets->hot_access_fraction)
+	i = rand_double (offsets->key, offsets->stream, counter + 1) *
+	  offsets->hot_size;
+      else
+	i = offsets->hot_size +
+	  (iore_size_t) (rand_double (offsets->key, offsets->stream,
+				      counter + 1) * cold_size);
+      break;
+    default: /* GAUSSIAN around a center moving through the space */
+      center = ((offsets->next + 0.5) / offsets->count) * offsets->space;
+      u = center + offsets->stddev *
+	rand_normal (offsets->key, offsets->stream, counter);
+      i = (iore_size_t) floor (fmod (u, (double) offsets->space));
+      if (i < 0)
+	i += offsets->space;
+    }
+
+  if (i >= offsets->space) /* rounding */
+    i = offsets->space - 1;
+
+  return (i);
+} /* sample (iore_offsets_t *) */
+
+/*
+ * Setup the distributions of skewed patterns over the sampled space.
+ */
+static void
+setup_sampling (iore_offsets_t *offsets, iore_params_t *params)
+{
+  setup_zipf (&offsets->zipf, offsets->space, params->zipf_theta);
+  offsets->hot_size = (iore_size_t) (params->hot_fraction * offsets->space);
+  if (offsets->hot_size < 1)
+    offsets->hot_size = 1;
+  offsets->hot_access_fraction = params->hot_access_fraction;
+  offsets->stddev = params->gaussian_stddev * offsets->space;
+} /* setup_sampling (iore_offsets_t *, iore_params_t *) */
+
+/*
+ * Compute the offset and length of the i-th transfer of the task according to
+ * the file layout.
+ */
+static void
+place (iore_offsets_t *offsets, iore_size_t i, iore_offset_t *offset,
+       iore_size_t *length)
+{
+  iore_size_t s, j;
+
+  switch (offsets->file_layout)
+    {
+    case INTERLEAVED:
+      *offset = ((i * offsets->num_tasks) + offsets->rank) *
+	offsets->transfer_size;
+      *length = offsets->transfer_size;
+      return;
+    case SEGMENTED:
+      s = i / offsets->per_segment;
+      j = i % offsets->per_segment;
+      break;
+    default: /* CONTIGUOUS */
+      s = 0;
+      j = i;
+    }
+
+  *offset = offsets->first + (s * offsets->segment_size) +
+    (j * offsets->transfer_size);
+
+  /* the last transfer of a block may be shorter */
+  *length = offsets->block_size - (j * offsets->transfer_size);
+  if (*length > offsets->transfer_size)
+    *length = offsets->transfer_size;
+} /* place (iore_offsets_t *, iore_size_t, iore_offset_t *, iore_size_t *) */
+
+/*
+ * Compute the first offset of a rank in a shared file. For a rank equal to the
+ * number of tasks, it is the size of the shared file.
+ */
+static iore_offset_t
+get_first_offset (int rank, iore_params_t *params)
+{
+  iore_offset_t first = 0;
+  int i, q, r;
+
+  /* q is the integer number of loops over all block sizes */
+  q = rank / params->block_sizes_length;
+  if (q > 0)
+    {
+      for (i = 0; i < params->block_sizes_length; i++)
+	first += params->block_sizes[i];
+
+      first *= q;
+    }
+
+  /* r is the remainder loops over block sizes */
+  r = rank % params->block_sizes_length;
+  for (i = 0; i < r; i++)
+    first += params->block_sizes[i];
+
+  return (first);
+} /* get_first_offset (int, iore_params_t *) */
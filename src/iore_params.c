@@ -27,13 +27,74 @@ new_params ()
 
   params->num_tasks = 1;
   strcpy(params->api, "POSIX");
+  params->workload = STANDARD;
+  strcpy(params->trace_file_name, "");
+  params->trace_timing = FALSE;
+  strcpy(params->trace_capture_file_name, "");
+  params->trace_buffer_records = 65536;
+  params->num_checkpoints = 4;
+  params->compute_time = 1.0;
+  params->compute_busy = FALSE;
+  params->num_shards = 8;
+  params->samples_per_shard = 1024;
+  params->sample_size = 131072;
+  params->max_sample_size = 0;
+  params->num_epochs = 2;
+  params->prefetch_threads = 4;
+  params->prefetch_depth = 16;
+  params->record_size = 4096;
+  params->records_per_task = 1024;
+  params->appenders_per_file = 0;
+  params->files_per_task = 1024;
+  params->file_size_distribution = FIXED_SIZE;
+  params->file_size = 4096;
+  params->max_file_size = 0;
+  params->file_size_sigma = 1.0;
+  strcpy(params->file_size_histogram, "");
+  params->tree_depth = 2;
+  params->tree_fanout = 4;
+  params->items_per_dir = 16;
+  params->unique_dir_per_task = TRUE;
+  params->visibility_records = 100;
+  params->visibility_timeout = 1.0;
   params->sharing_policy = SHARED_FILE;
   params->access_pattern = SEQUENTIAL;
+  params->file_layout = CONTIGUOUS;
+  params->segment_count = 1;
+  params->zipf_theta = 0.99;
+  params->hot_fraction = 0.2;
+  params->hot_access_fraction = 0.8;
+  params->gaussian_stddev = 0.05;
+  params->access_stride = 2;
   params->block_sizes = block_sizes;
   params->transfer_sizes = transfer_size;
 
   params->write_test = TRUE;
   params->read_test = TRUE;
+  params->mixed_test = FALSE;
+  params->read_fraction = 0.5;
+  params->preallocation = NO_PREALLOCATION;
+  params->punch_holes = FALSE;
+  params->durability = NO_DURABILITY;
+  params->drop_cache_before_read = FALSE;
+  params->sync_interval = 0;
+  params->open_files_per_task = 1;
+  params->open_file_selection = ROUND_ROBIN_FILES;
+  params->dirty_fraction = 1.0;
+  params->dirty_selection = SCATTERED;
+  params->dirty_cluster_size = 16;
+  params->update_test = FALSE;
+  params->update_size = 0;
+  params->fs_block_size = 4096;
+  params->stripe_size = 1048576;
+  params->misalignment = 0;
+  params->misalignment_steps = 0;
+  params->arrival_process = CLOSED_LOOP;
+  params->target_iops = 0;
+  params->target_bandwidth = 0;
+  params->burst_size = 16;
+  params->queue_depth = 1;
+  params->max_queue_depth = 0;
 
   params->ref_num = -1;
   strcpy(params->root_file_name, "testfile");
@@ -41,12 +102,14 @@ new_params ()
   params->inter_test_delay = 0;
   params->intra_test_barrier = FALSE;
   params->run_time_limit = 0;
+  params->stonewall = 0;
   params->keep_file = FALSE;
   params->use_existing_file = FALSE;
   params->use_rep_in_file_name = FALSE;
   params->dir_per_file = FALSE;
   params->reorder_tasks = FALSE;
   params->reorder_tasks_offset = 0;
+  params->random_seed = -1;
 
   params->single_io_attempt = FALSE;
 
@@ -0,0 +1,246 @@
+#include <stdint.h>
+#include <math.h>
+
+#include "iore_rand.h"
+#include "util.h"
+
+/******************************************************************************
+ * D E F I N I T I O N S
+ ******************************************************************************/
+
+#define PHILOX_ROUNDS 10
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+static void philox4x32 (uint32_t *, uint32_t *);
+static double zipf_h (iore_zipf_t *, double);
+static double zipf_h_integral (iore_zipf_t *, double);
+static double zipf_h_integral_inverse (iore_zipf_t *, double);
+
+/******************************************************************************
+ * F U N C T I O N S
+ ******************************************************************************/
+
+/*
+ * Returns the random 64-bit word at a counter of a stream of the generator.
+ * The generator is counter-based (Philox4x32-10): any word is computed
+ * directly from the key, stream and counter, without any state, so tasks can
+ * compute the same sequence independently and in any order.
+ */
+unsigned long long
+rand_u64 (unsigned long long key, unsigned long long stream,
+	  unsigned long long counter)
+{
+  uint32_t ctr[4];
+  uint32_t k[2];
+
+  ctr[0] = (uint32_t) counter;
+  ctr[1] = (uint32_t) (counter >> 32);
+  ctr[2] = (uint32_t) stream;
+  ctr[3] = (uint32_t) (stream >> 32);
+  k[0] = (uint32_t) key;
+  k[1] = (uint32_t) (key >> 32);
+
+  philox4x32 (ctr, k);
+
+  return (((unsigned long long) ctr[0] << 32) | ctr[1]);
+} /* rand_u64 (unsigned long long, unsigned long long, unsigned long long) */
+
+/*
+ * Returns the random double in [0, 1) at a counter of a stream.
+ */
+double
+rand_double (unsigned long long key, unsigned long long stream,
+	     unsigned long long counter)
+{
+  return ((rand_u64 (key, stream, counter) >> 11) * (1.0 / 9007199254740992.0));
+} /* rand_double (unsigned long long, unsigned long long, ...) */
+
+/*
+ * Setup a random permutation of the integers in [0, size). The permutation is
+ * a balanced Feistel network over the smallest even power of two covering the
+ * size, so any of its elements is computed without storing the others.
+ */
+void
+setup_perm (iore_perm_t *perm, unsigned long long key,
+	    unsigned long long stream, iore_size_t size)
+{
+  int bits = 1;
+
+  while (bits < 62 && (1ULL << bits) < (unsigned long long) size)
+    bits++;
+
+  perm->key = key;
+  perm->stream = stream;
+  perm->size = size;
+  perm->half_bits = (bits + 1) / 2;
+} /* setup_perm (iore_perm_t *, unsigned long long, unsigned long long, ...) */
+
+/*
+ * Returns the i-th element of a random permutation. Values outside the
+ * permutation size are walked over until one falls inside; since the domain
+ * is at most four times the size, few rounds are expected.
+ */
+iore_size_t
+permute (iore_perm_t *perm, iore_size_t i)
+{
+  unsigned long long mask = (1ULL << perm->half_bits) - 1;
+  unsigned long long x = (unsigned long long) i;
+  unsigned long long left, right, tmp;
+  unsigned long long j;
+
+  do
+    {
+      left = x >> perm->half_bits;
+      right = x & mask;
+
+      for (j = 0; j < FEISTEL_ROUNDS; j++)
+	{
+	  tmp = right;
+	  right = left ^ (rand_u64 (perm->key, perm->stream,
+				    (j << 32) | right) & mask);
+	  left = tmp;
+	}
+
+      x = (left << perm->half_bits) | right;
+    }
+  while (x >= (unsigned long long) perm->size);
+
+  return ((iore_size_t) x);
+} /* permute (iore_perm_t *, iore_size_t) */
+
+/*
+ * Returns a normally distributed double (zero mean, unit deviation) from the
+ * counters 2 * counter and 2 * counter + 1 of a stream (Box-Muller).
+ */
+double
+rand_normal (unsigned long long key, unsigned long long stream,
+	     unsigned long long counter)
+{
+  double u1, u2;
+
+  u1 = 1.0 - rand_double (key, stream, 2 * counter); /* in (0, 1] */
+  u2 = rand_double (key, stream, (2 * counter) + 1);
+
+  return (sqrt (-2.0 * log (u1)) * cos (2.0 * M_PI * u2));
+} /* rand_normal (unsigned long long, unsigned long long, ...) */
+
+/*
+ * Setup a Zipf distribution over the integers in [1, size] with a given
+ * exponent. Samples are drawn by rejection-inversion (Hormann and Derflinger),
+ * which takes constant time and memory regardless of the size.
+ */
+void
+setup_zipf (iore_zipf_t *zipf, iore_size_t size, double theta)
+{
+  zipf->size = size;
+  zipf->theta = theta;
+  zipf->h_x1 = zipf_h_integral (zipf, 1.5) - 1.0;
+  zipf->h_n = zipf_h_integral (zipf, size + 0.5);
+  zipf->s = 2.0 - zipf_h_integral_inverse (zipf, zipf_h_integral (zipf, 2.5) -
+					   zipf_h (zipf, 2.0));
+} /* setup_zipf (iore_zipf_t *, iore_size_t, double) */
+
+/*
+ * Returns a Zipf distributed integer in [1, size]. Each rejected candidate
+ * consumes one more counter of the stream, starting at the given one; the
+ * expected number of candidates is close to one.
+ */
+iore_size_t
+rand_zipf (iore_zipf_t *zipf, unsigned long long key, unsigned long long stream,
+	   unsigned long long counter)
+{
+  iore_size_t k;
+  double u, x;
+
+  for (;;)
+    {
+      u = zipf->h_n + rand_double (key, stream, counter++) *
+	(zipf->h_x1 - zipf->h_n);
+      x = zipf_h_integral_inverse (zipf, u);
+
+      k = (iore_size_t) (x + 0.5);
+      if (k < 1)
+	k = 1;
+      else if (k > zipf->size)
+	k = zipf->size;
+
+      if (k - x <= zipf->s ||
+	  u >= zipf_h_integral (zipf, k + 0.5) - zipf_h (zipf, k))
+	return (k);
+    }
+} /* rand_zipf (iore_zipf_t *, unsigned long long, unsigned long long, ...) */
+
+/*
+ * Hat function of the Zipf rejection-inversion.
+ */
+static double
+zipf_h (iore_zipf_t *zipf, double x)
+{
+  return (exp (-zipf->theta * log (x)));
+} /* zipf_h (iore_zipf_t *, double) */
+
+/*
+ * Integral of the hat function, (x^(1 - theta) - 1) / (1 - theta), computed
+ * stably when theta is close to one.
+ */
+static double
+zipf_h_integral (iore_zipf_t *zipf, double x)
+{
+  double log_x = log (x);
+  double t = (1.0 - zipf->theta) * log_x;
+
+  if (fabs (t) > 1e-8)
+    return ((expm1 (t) / t) * log_x);
+  else
+    return ((1.0 + t * 0.5 * (1.0 + t / 3.0 * (1.0 + 0.25 * t))) * log_x);
+} /* zipf_h_integral (iore_zipf_t *, double) */
+
+/*
+ * Inverse of the integral of the hat function.
+ */
+static double
+zipf_h_integral_inverse (iore_zipf_t *zipf, double x)
+{
+  double t = x * (1.0 - zipf->theta);
+
+  if (t < -1.0)
+    t = -1.0; /* limit of the domain, due to rounding */
+
+  if (fabs (t) > 1e-8)
+    return (exp ((log1p (t) / t) * x));
+  else
+    return (exp ((1.0 - t * (0.5 - t * (1.0 / 3.0 - 0.25 * t))) * x));
+} /* zipf_h_integral_inverse (iore_zipf_t *, double) */
+
+/*
+ * Philox4x32-10 block function: encrypts the counter in place with the key.
+ */
+static void
+philox4x32 (uint32_t *ctr, uint32_t *key)
+{
+  uint64_t p0, p1;
+  uint32_t k0 = key[0];
+  uint32_t k1 = key[1];
+  int i;
+
+  for (i = 0; i < PHILOX_ROUNDS; i++)
+    {
+      p0 = (uint64_t) PHILOX_M0 * ctr[0];
+      p1 = (uint64_t) PHILOX_M1 * ctr[2];
+
+      ctr[0] = (uint32_t) (p1 >> 32) ^ ctr[1] ^ k0;
+      ctr[1] = (uint32_t) p1;
+      ctr[2] = (uint32_t) (p0 >> 32) ^ ctr[3] ^ k1;
+      ctr[3] = (uint32_t) p0;
+
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+    }
+} /* philox4x32 (uint32_t *, uint32_t *) */
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <mpi.h>
+
+#include "iore_rand.h"
+#include "iore_sizes.h"
+#include "util.h"
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+static void read_histogram (iore_sizes_t *, char *);
+
+/******************************************************************************
+ * F U N C T I O N S
+ ******************************************************************************/
+
+/*
+ * Setup the distribution of file sizes of a run from a stream of the
+ * generator. FIXED sizes are file_size, UNIFORM sizes are in [file_size,
+ * max_file_size], LOGNORMAL sizes have median file_size and are capped at
+ * max_file_size, and EMPIRICAL sizes are those of the bins of the histogram
+ * file.
+ */
+iore_sizes_t *
+new_sizes (iore_params_t *params, unsigned long long stream)
+{
+  iore_sizes_t *sizes;
+
+  sizes = (iore_sizes_t *) malloc (sizeof (iore_sizes_t));
+  if (sizes == NULL)
+    {
+      FATAL("Failed to allocate memory for the file sizes");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  sizes->distribution = params->file_size_distribution;
+  sizes->min_size = params->file_size;
+  sizes->max_size = params->file_size;
+  sizes->sigma = params->file_size_sigma;
+  sizes->num_bins = 0;
+  sizes->bin_sizes = NULL;
+  sizes->bin_cdf = NULL;
+  sizes->key = params->random_seed;
+  sizes->stream = stream;
+
+  if (sizes->distribution == UNIFORM_SIZE ||
+      sizes->distribution == LOGNORMAL_SIZE)
+    sizes->max_size = params->max_file_size;
+  else if (sizes->distribution == EMPIRICAL_SIZE)
+    read_histogram (sizes, params->file_size_histogram);
+
+  return (sizes);
+} /* new_sizes (iore_params_t *, unsigned long long) */
+
+/*
+ * Returns the size of the i-th file. LOGNORMAL sizes are at least one byte,
+ * and capped before the conversion to an integer, and EMPIRICAL bins are found by a binary search of the cumulative fractions.
+ */
+iore_size_t
+draw_size (iore_sizes_t *sizes, iore_size_t i)
+{
+  double size;
+  double u;
+  int lo, hi, mid;
+
+  switch (sizes->distribution)
+    {
+    case UNIFORM_SIZE:
+      return (sizes->min_size + (iore_size_t)
+	      (rand_u64 (sizes->key, sizes->stream, i) %
+	       (sizes->max_size - sizes->min_size + 1)));
+
+    case LOGNORMAL_SIZE:
+      size = sizes->min_size * exp (sizes->sigma *
+				    rand_normal (sizes->key, sizes->stream, i));
+      if (size < 1)
+	return (1);
+      if (size > sizes->max_size)
+	return (sizes->max_size);
+      return ((iore_size_t) size);
+
+    case EMPIRICAL_SIZE:
+      u = rand_double (sizes->key, sizes->stream, i);
+      lo = 0;
+      hi = sizes->num_bins - 1;
+      while (lo < hi)
+	{
+	  mid = (lo + hi) / 2;
+	  if (u < sizes->bin_cdf[mid])
+	    hi = mid;
+	  else
+	    lo = mid + 1;
+	}
+      return (sizes->bin_sizes[lo]);
+
+    default: /* FIXED_SIZE */
+      return (sizes->min_size);
+    }
+} /* draw_size (iore_sizes_t *, iore_size_t) */
+
+/*
+ * Release a distribution of file sizes.
+ */
+void
+free_sizes (iore_sizes_t *sizes)
+{
+  free (sizes->bin_sizes);
+  free (sizes->bin_cdf);
+  free (sizes);
+} /* free_sizes (iore_sizes_t *) */
+
+/*
+ * Read the histogram of an EMPIRICAL distribution: a text file with a line
+ * "<size in bytes> <weight>" for each bin; blank lines and lines starting with
+ * '#' are ignored, and weights need not add up to one.
+ */
+static void
+read_histogram (iore_sizes_t *sizes, char *file_name)
+{
+  char line[MAX_STR_LEN];
+  iore_size_t size;
+  double weight;
+  double total = 0;
+  int capacity = 0;
+  FILE *file;
+  int i;
+
+  file = fopen (file_name, "r");
+  if (file == NULL)
+    {
+      FATALF("Could not open the file size histogram %s", file_name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  while (fgets (line, sizeof (line), file) != NULL)
+    {
+      if (line[strspn (line, " \t\r\n")] == '\0' || line[0] == '#')
+	continue;
+
+      if (sscanf (line, "%lld %lf", &size, &weight) != 2 || size < 1 ||
+	  weight < 0)
+	{
+	  FATALF("Invalid bin in the file size histogram %s", file_name);
+	  MPI_Abort (MPI_COMM_WORLD, -1);
+	}
+
+      if (sizes->num_bins == capacity)
+	{
+	  capacity = (capacity == 0) ? 16 : 2 * capacity;
+	  sizes->bin_sizes = (iore_size_t *)
+	    realloc (sizes->bin_sizes, capacity * sizeof (iore_size_t));
+	  sizes->bin_cdf = (double *)
+	    realloc (sizes->bin_cdf, capacity * sizeof (double));
+	  if (sizes->bin_sizes == NULL || sizes->bin_cdf == NULL)
+	    {
+	      FATAL("Failed to allocate memory for the file size histogram");
+	      MPI_Abort (MPI_COMM_WORLD, -1);
+	    }
+	}
+
+      sizes->bin_sizes[sizes->num_bins] = size;
+      sizes->bin_cdf[sizes->num_bins] = weight;
+      sizes->num_bins++;
+      total += weight;
+    }
+  fclose (file);
+
+  if (total <= 0)
+    {
+      FATALF("The file size histogram %s has no weight", file_name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  /* turn weights into cumulative fractions, the last one exactly one */
+  sizes->max_size = 0;
+  weight = 0;
+  for (i = 0; i < sizes->num_bins; i++)
+    {
+      weight += sizes->bin_cdf[i];
+      sizes->bin_cdf[i] = weight / total;
+      if (sizes->bin_sizes[i] > sizes->max_size)
+	sizes->max_size = sizes->bin_sizes[i];
+    }
+  sizes->bin_cdf[sizes->num_bins - 1] = 1.0;
+} /* read_histogram (iore_sizes_t *, char *) */
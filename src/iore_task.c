@@ -28,6 +28,8 @@ iore_task_t
   task->verbosity = NORMAL;
   task->wclock_delta = 0;
   task->wclock_skew_all = 0;
+  task->capture = NULL;
+  task->counter_time = -1;
 
   set_wclock_deviation(task);
 
@@ -0,0 +1,231 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <mpi.h>
+
+#include "iore_trace.h"
+#include "util.h"
+
+/******************************************************************************
+ * P R O T O T Y P E S
+ ******************************************************************************/
+
+static void write_records (iore_capture_t *);
+static void write_header (iore_capture_t *, uint64_t);
+
+/******************************************************************************
+ * F U N C T I O N S
+ ******************************************************************************/
+
+/*
+ * Map a trace file in memory for reading. Records are read in place through
+ * the mapping, so the memory used does not depend on the size of the trace,
+ * apart from the pages cached by the kernel.
+ */
+iore_trace_t *
+open_trace (char *file_name)
+{
+  iore_trace_t *trace;
+  iore_trace_header_t *header;
+  struct stat st;
+
+  trace = (iore_trace_t *) malloc (sizeof (iore_trace_t));
+  if (trace == NULL)
+    {
+      FATAL("Failed to allocate memory for the trace");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  trace->fd = open (file_name, O_RDONLY);
+  if (trace->fd < 0 || fstat (trace->fd, &st) != 0)
+    {
+      FATALF("Could not open the trace file %s", file_name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if ((size_t) st.st_size < sizeof (iore_trace_header_t))
+    {
+      FATALF("The trace file %s is truncated", file_name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  trace->size = st.st_size;
+  trace->map = mmap (NULL, trace->size, PROT_READ, MAP_SHARED, trace->fd, 0);
+  if (trace->map == MAP_FAILED)
+    {
+      FATALF("Could not map the trace file %s", file_name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  /* records are replayed in order, so read ahead aggressively */
+  madvise (trace->map, trace->size, MADV_SEQUENTIAL);
+
+  header = (iore_trace_header_t *) trace->map;
+  if (strncmp (header->magic, TRACE_MAGIC, sizeof (header->magic)) != 0 ||
+      header->version != TRACE_VERSION ||
+      header->record_size != sizeof (iore_trace_record_t))
+    {
+      FATALF("%s is not a trace file of version %d", file_name,
+	     TRACE_VERSION);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  if (header->num_records > (trace->size - sizeof (iore_trace_header_t)) /
+      sizeof (iore_trace_record_t))
+    {
+      FATALF("The trace file %s is truncated", file_name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  trace->records = (iore_trace_record_t *) (header + 1);
+  trace->num_records = header->num_records;
+
+  return (trace);
+} /* open_trace (char *) */
+
+/*
+ * Unmap and close a trace file.
+ */
+void
+close_trace (iore_trace_t *trace)
+{
+  munmap (trace->map, trace->size);
+  close (trace->fd);
+  free (trace);
+} /* close_trace (iore_trace_t *) */
+
+/*
+ * Create a trace file and start capturing records into it, through a buffer
+ * of the given number of records. Adding a record is a copy into the buffer;
+ * the trace file is only written by flush_capture, outside of the measured
+ * phases, unless the buffer fills up during a test.
+ */
+iore_capture_t *
+new_capture (char *file_name, iore_size_t num_records)
+{
+  iore_capture_t *capture;
+
+  capture = (iore_capture_t *) malloc (sizeof (iore_capture_t));
+  if (capture != NULL)
+    capture->buffer = (iore_trace_record_t *)
+      malloc (num_records * sizeof (iore_trace_record_t));
+  if (capture == NULL || capture->buffer == NULL)
+    {
+      FATAL("Failed to allocate memory for the trace capture");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  capture->fd = open (file_name, O_WRONLY | O_CREAT | O_TRUNC,
+		      S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  if (capture->fd < 0)
+    {
+      FATALF("Could not create the trace file %s", file_name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  capture->capacity = num_records;
+  capture->count = 0;
+  capture->written = 0;
+  capture->stalls = 0;
+
+  write_header (capture, 0);
+  if (lseek (capture->fd, sizeof (iore_trace_header_t), SEEK_SET) < 0)
+    {
+      FATALF("Failed seeking the trace file %s", file_name);
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  return (capture);
+} /* new_capture (char *, iore_size_t) */
+
+/*
+ * Add a record to a capture. If the buffer is full, the task writes it to the
+ * trace file in the middle of the test, and the write is counted as a stall.
+ */
+void
+capture_record (iore_capture_t *capture, iore_trace_record_t *record)
+{
+  if (capture->count == capture->capacity)
+    {
+      capture->stalls++;
+      write_records (capture);
+    }
+
+  capture->buffer[capture->count++] = *record;
+} /* capture_record (iore_capture_t *, iore_trace_record_t *) */
+
+/*
+ * Write the captured records to the trace file, and update its header, so the
+ * file is a complete trace at this point. Called after the stop timer of a
+ * test, so the writes are not measured.
+ */
+void
+flush_capture (iore_capture_t *capture)
+{
+  write_records (capture);
+  write_header (capture, capture->written);
+} /* flush_capture (iore_capture_t *) */
+
+/*
+ * Stop capturing, and close the trace file.
+ */
+void
+close_capture (iore_capture_t *capture)
+{
+  flush_capture (capture);
+
+  if (capture->stalls > 0)
+    WARNF("Trace capture wrote a full buffer %llu times during tests; "
+	  "consider a larger trace_buffer_records",
+	  (unsigned long long) capture->stalls);
+
+  close (capture->fd);
+  free (capture->buffer);
+  free (capture);
+} /* close_capture (iore_capture_t *) */
+
+/*
+ * Write the records in the buffer to the trace file, and empty the buffer.
+ */
+static void
+write_records (iore_capture_t *capture)
+{
+  size_t size = capture->count * sizeof (iore_trace_record_t);
+
+  if (capture->count == 0)
+    return;
+
+  if (write (capture->fd, capture->buffer, size) != (ssize_t) size)
+    {
+      FATAL("Failed to write to the trace file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+
+  capture->written += capture->count;
+  capture->count = 0;
+} /* write_records (iore_capture_t *) */
+
+/*
+ * Write the header of a trace file with a number of records.
+ */
+static void
+write_header (iore_capture_t *capture, uint64_t num_records)
+{
+  iore_trace_header_t header;
+
+  memset (&header, 0, sizeof (header));
+  strcpy (header.magic, TRACE_MAGIC);
+  header.version = TRACE_VERSION;
+  header.record_size = sizeof (iore_trace_record_t);
+  header.num_records = num_records;
+
+  if (pwrite (capture->fd, &header, sizeof (header), 0) != sizeof (header))
+    {
+      FATAL("Failed to write the header of the trace file");
+      MPI_Abort (MPI_COMM_WORLD, -1);
+    }
+} /* write_header (iore_capture_t *, uint64_t) */
@@ -11,6 +11,20 @@
 
 #include "json.h"
 
+/******************************************************************************
+ * D E F I N I T I O N S
+ ******************************************************************************/
+
+#define ERRMSG_HEADER "Errors were found in the parameters definitions:\n"
+
+/* room left for the accumulated messages in a message of ERRF */
+#define MAX_ERRMSG_LEN (MAX_STR_LEN - sizeof (ERRMSG_HEADER))
+
+/* accumulate an error message of parse_file_params, truncated past the end of
+   its buffer */
+#define ERRMSG(MSG)						\
+  strncat (errmsg_acc, MSG, MAX_ERRMSG_LEN - strlen (errmsg_acc) - 1)
+
 /******************************************************************************
  * P R O T O T Y P E S
  ******************************************************************************/
@@ -19,6 +33,7 @@ static char *get_file_data (char *);
 static void parse_file_run (json_value *, iore_run_t *);
 static void parse_file_params (json_value *, iore_params_t *);
 static iore_size_t string_to_bytes (char *);
+static int get_number (json_value *, double *);
 
 /******************************************************************************
  * F U N C T I O N S
@@ -221,7 +236,8 @@ parse_file_params (json_value *params, iore_params_t *iore_params)
   char *param_name;
   int num_params;
   int num_errors = 0;
-  char *errmsg_acc = NULL;
+  char errmsg_acc[MAX_ERRMSG_LEN] = "";
+  double number;
   int length;
   int i, j;
   
@@ -243,7 +259,7 @@ parse_file_params (json_value *params, iore_params_t *iore_params)
 	{
 	  if (param->type != json_integer || param->u.integer < 0)
 	    {
-	      strcat(errmsg_acc, "num_tasks must be a positive integer\n");
+	      ERRMSG("num_tasks must be a positive integer\n");
 	      num_errors++;
 	    }
 	  else
@@ -255,7 +271,7 @@ parse_file_params (json_value *params, iore_params_t *iore_params)
 	{
 	  if (param->type != json_string)
 	    {
-	      strcat(errmsg_acc, "api must be a string\n");
+	      ERRMSG("api must be a string\n");
 	      num_errors++;
 	    }
 	  else
@@ -263,402 +279,1267 @@ parse_file_params (json_value *params, iore_params_t *iore_params)
 	      strcpy(iore_params->api, param->u.string.ptr);
 	    }
 	}
-      else if (STREQUAL(param_name, "sharing_policy"))
+      else if (STREQUAL(param_name, "workload"))
 	{
 	  if (param->type != json_string ||
-	      !(STREQUAL(param->u.string.ptr, "SHARED_FILE") ||
-		STREQUAL(param->u.string.ptr, "FILE_PER_PROCESS")))
+	      !(STREQUAL(param->u.string.ptr, "STANDARD") ||
+		STREQUAL(param->u.string.ptr, "TRACE_REPLAY") ||
+		STREQUAL(param->u.string.ptr, "CHECKPOINT_RESTART") ||
+		STREQUAL(param->u.string.ptr, "DATA_LOADER") ||
+		STREQUAL(param->u.string.ptr, "LOG_APPEND") ||
+		STREQUAL(param->u.string.ptr, "SMALL_FILES") ||
+		STREQUAL(param->u.string.ptr, "METADATA") ||
+		STREQUAL(param->u.string.ptr, "VISIBILITY")))
 	    {
-	      strcat(errmsg_acc,
-		     "sharing_policy must be either \"SHARED_FILE\""
-		     "or \"FILE_PER_PROCESS\"\n");
+	      ERRMSG("workload must be either \"STANDARD\", \"TRACE_REPLAY\", "
+		     "\"CHECKPOINT_RESTART\", \"DATA_LOADER\", "
+		     "\"LOG_APPEND\", \"SMALL_FILES\", \"METADATA\" or "
+		     "\"VISIBILITY\"\n");
 	      num_errors++;
 	    }
+	  else if (STREQUAL(param->u.string.ptr, "STANDARD"))
+	    iore_params->workload = STANDARD;
+	  else if (STREQUAL(param->u.string.ptr, "TRACE_REPLAY"))
+	    iore_params->workload = TRACE_REPLAY;
+	  else if (STREQUAL(param->u.string.ptr, "CHECKPOINT_RESTART"))
+	    iore_params->workload = CHECKPOINT_RESTART;
+	  else if (STREQUAL(param->u.string.ptr, "DATA_LOADER"))
+	    iore_params->workload = DATA_LOADER;
+	  else if (STREQUAL(param->u.string.ptr, "LOG_APPEND"))
+	    iore_params->workload = LOG_APPEND;
+	  else if (STREQUAL(param->u.string.ptr, "SMALL_FILES"))
+	    iore_params->workload = SMALL_FILES;
+	  else if (STREQUAL(param->u.string.ptr, "METADATA"))
+	    iore_params->workload = METADATA;
 	  else
+	    iore_params->workload = VISIBILITY;
+	}
+      else if (STREQUAL(param_name, "trace_file_name"))
+	{
+	  if (param->type != json_string ||
+	      param->u.string.length >= MAXPATHLEN)
 	    {
-	      iore_params->sharing_policy = STREQUAL(param->u.string.ptr,
-						     "SHARED_FILE") ?
-		SHARED_FILE : FILE_PER_PROCESS;
+	      ERRMSG("trace_file_name must be a string\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      strcpy(iore_params->trace_file_name, param->u.string.ptr);
 	    }
 	}
-      else if (STREQUAL(param_name, "access_pattern"))
+      else if (STREQUAL(param_name, "trace_timing"))
 	{
-	  if (param->type != json_string ||
-	      !(STREQUAL(param->u.string.ptr, "SEQUENTIAL") ||
-		STREQUAL(param->u.string.ptr, "RANDOM")))
+	  if (param->type != json_boolean)
 	    {
-	      strcat(errmsg_acc,
-		     "access_pattern must be either \"SEQUENTIAL\""
-		     "or \"RANDOM\"\n");
+	      ERRMSG("trace_timing must be either true of false\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->access_pattern = STREQUAL(param->u.string.ptr,
-						     "SEQUENTIAL") ?
-		SEQUENTIAL : RANDOM;
+	      iore_params->trace_timing = param->u.boolean;
 	    }
 	}
-      else if (STREQUAL(param_name, "block_sizes"))
+      else if (STREQUAL(param_name, "trace_capture_file_name"))
 	{
-	  if (param->type == json_integer)
+	  if (param->type != json_string ||
+	      param->u.string.length >= MAXPATHLEN)
 	    {
-	      if (param->u.integer < 1)
-		{
-		  strcat(errmsg_acc, "block_sizes must be greater than 0\n");
-		  num_errors++;
-		}
-	      else
-		{
-		  iore_params->block_sizes =
-		    (iore_size_t *) malloc(sizeof(iore_size_t));
-		  iore_params->block_sizes[0] = param->u.integer;
-		  iore_params->block_sizes_length = 1;
-		}
+	      ERRMSG("trace_capture_file_name must be a string\n");
+	      num_errors++;
 	    }
-	  else if (param->type == json_string)
+	  else
 	    {
-	      iore_params->block_sizes =
-		(iore_size_t *) malloc(sizeof(iore_size_t));
-
-	      if ((iore_params->block_sizes[0] =
-		   string_to_bytes(param->u.string.ptr)) < 1)
-		{
-		  strcat(errmsg_acc, "block_sizes must be greater than 0\n");
-		  num_errors++;
-		}
-	      iore_params->block_sizes_length = 1;
+	      strcpy(iore_params->trace_capture_file_name, param->u.string.ptr);
 	    }
-	  else if (param->type == json_array)
+	}
+      else if (STREQUAL(param_name, "trace_buffer_records"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
 	    {
-	      length = param->u.array.length;
-	      iore_params->block_sizes =
-		(iore_size_t *) malloc(length * sizeof(iore_size_t));
-
-	      for (j = 0; j < length; j++)
-		{
-		  value = param->u.array.values[j];
-		  if (value->type == json_integer)
-		    {
-		      if (value->u.integer < 1)
-			{
-			  strcat(errmsg_acc,
-				 "block_sizes must be greater than 0\n");
-			  num_errors++;
-			}
-		      else
-			{
-			  iore_params->block_sizes[j] = value->u.integer;
-			}
-		    }
-		  else if (value->type == json_string)
-		    {
-		      if ((iore_params->block_sizes[j] =
-			   string_to_bytes(value->u.string.ptr)) < 1)
-			{
-			  strcat(errmsg_acc,
-				 "block_sizes must be greater than 0\n");
-			  num_errors++;
-			}
-		    }
-		  else
-		    {
-		      strcat(errmsg_acc, "block_sizes must be "
-			     "by an integer number of bytes, "
-			     "or a string formed by an integer plus a unit\n");
-		      num_errors++;
-		    }
-		}
-	      iore_params->block_sizes_length = length;
+	      ERRMSG("trace_buffer_records must be greater than zero\n");
+	      num_errors++;
 	    }
 	  else
 	    {
-	      strcat(errmsg_acc, "block_sizes must be "
-		     "an integer number of bytes, "
-		     "a string formed by an integer plus a unit, "
-		     "or an array of integers or of integers plus units\n");
+	      iore_params->trace_buffer_records = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "num_checkpoints"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("num_checkpoints must be greater than zero\n");
 	      num_errors++;
 	    }
+	  else
+	    {
+	      iore_params->num_checkpoints = param->u.integer;
+	    }
 	}
-      else if (STREQUAL(param_name, "transfer_sizes"))
+      else if (STREQUAL(param_name, "compute_time"))
 	{
-	  if (param->type == json_integer)
+	  if (!get_number(param, &number) || number < 0)
 	    {
-	      if (param->u.integer < 1)
-		{
-		  strcat(errmsg_acc, "transfer_sizes must be greater than 0\n");
-		  num_errors++;
-		}
-	      else
-		{
-		  iore_params->transfer_sizes =
-		    (iore_size_t *) malloc(sizeof(iore_size_t));
-		  iore_params->transfer_sizes[0] = param->u.integer;
-		  iore_params->transfer_sizes_length = 1;
-		}
+	      ERRMSG("compute_time must not be negative\n");
+	      num_errors++;
 	    }
-	  else if (param->type == json_string)
+	  else
 	    {
-	      iore_params->transfer_sizes =
-		(iore_size_t *) malloc(sizeof(iore_size_t));
-
-	      if ((iore_params->transfer_sizes[0] =
-		   string_to_bytes(param->u.string.ptr)) < 1)
-		{
-		  strcat(errmsg_acc, "transfer_sizes must be greater than 0\n");
-		  num_errors++;
-		}
-	      iore_params->transfer_sizes_length = 1;
+	      iore_params->compute_time = number;
 	    }
-	  else if (param->type == json_array)
+	}
+      else if (STREQUAL(param_name, "compute_busy"))
+	{
+	  if (param->type != json_boolean)
 	    {
-	      length = param->u.array.length;
-	      iore_params->transfer_sizes =
-		(iore_size_t *) malloc(length * sizeof(iore_size_t));
-
-	      for (j = 0; j < length; j++)
-		{
-		  value = param->u.array.values[j];
-		  if (value->type == json_integer)
-		    {
-		      if (value->u.integer < 1)
-			{
-			  strcat(errmsg_acc,
-				 "transfer_sizes must be greater than 0\n");
-			  num_errors++;
-			}
-		      else
-			{
-			  iore_params->transfer_sizes[j] = value->u.integer;
-			}
-		    }
-		  else if (value->type == json_string)
-		    {
-		      if ((iore_params->transfer_sizes[j] =
-			   string_to_bytes(value->u.string.ptr)) < 1)
-			{
-			  strcat(errmsg_acc,
-				 "transfer_sizes must be greater than 0\n");
-			  num_errors++;
-			}
-		    }
-		  else
-		    {
-		      strcat(errmsg_acc, "transfer_sizes must be "
-			     "by an integer number of bytes, "
-			     "or a string formed by an integer plus a unit\n");
-		      num_errors++;
-		    }
-		}
-	      iore_params->transfer_sizes_length = length;
+	      ERRMSG("compute_busy must be either true of false\n");
+	      num_errors++;
 	    }
 	  else
 	    {
-	      strcat(errmsg_acc, "transfer_sizes must be "
-		     "an integer number of bytes, "
-		     "a string formed by an integer plus a unit, "
-		     "or an array of integers or of integers plus units\n");
+	      iore_params->compute_busy = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "num_shards"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("num_shards must be greater than zero\n");
 	      num_errors++;
 	    }
+	  else
+	    {
+	      iore_params->num_shards = param->u.integer;
+	    }
 	}
-      else if (STREQUAL(param_name, "write_test"))
+      else if (STREQUAL(param_name, "samples_per_shard"))
 	{
-	  if (param->type != json_boolean)
+	  if (param->type != json_integer || param->u.integer < 1)
 	    {
-	      strcat(errmsg_acc, "write_test must be either true or false\n");
+	      ERRMSG("samples_per_shard must be greater than zero\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->write_test = param->u.boolean;
+	      iore_params->samples_per_shard = param->u.integer;
 	    }
 	}
-      else if (STREQUAL(param_name, "read_test"))
+      else if (STREQUAL(param_name, "sample_size"))
 	{
-	  if (param->type != json_boolean)
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) <= 0)
 	    {
-	      strcat(errmsg_acc, "read_test must be either true or false\n");
+	      ERRMSG("sample_size must be a size greater than "
+		     "zero, e.g. \"128K\"\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->read_test = param->u.boolean;
+	      iore_params->sample_size = string_to_bytes(param->u.string.ptr);
 	    }
 	}
-      else if (STREQUAL(param_name, "ref_num"))
+      else if (STREQUAL(param_name, "max_sample_size"))
 	{
-	  if (param->type != json_integer)
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) < 0)
 	    {
-	      strcat(errmsg_acc, "ref_num must be an integer\n");
+	      ERRMSG("max_sample_size must be a size, e.g. "
+		     "\"1M\"\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->ref_num = param->u.integer;
+	      iore_params->max_sample_size =
+		string_to_bytes(param->u.string.ptr);
 	    }
 	}
-      else if (STREQUAL(param_name, "root_file_name"))
+      else if (STREQUAL(param_name, "num_epochs"))
 	{
-	  if (param->type != json_string)
+	  if (param->type != json_integer || param->u.integer < 1)
 	    {
-	      strcat(errmsg_acc, "root_file_name must be a string\n");
+	      ERRMSG("num_epochs must be greater than zero\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      strcpy(iore_params->root_file_name, param->u.string.ptr);
+	      iore_params->num_epochs = param->u.integer;
 	    }
 	}
-      else if (STREQUAL(param_name, "num_repetitions"))
+      else if (STREQUAL(param_name, "prefetch_threads"))
 	{
 	  if (param->type != json_integer || param->u.integer < 1)
 	    {
-	      strcat(errmsg_acc,
-		     "num_repetitions must be a greater than zero\n");
+	      ERRMSG("prefetch_threads must be greater than zero\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->num_repetitions = param->u.integer;
+	      iore_params->prefetch_threads = param->u.integer;
 	    }
 	}
-      else if (STREQUAL(param_name, "inter_test_delay"))
+      else if (STREQUAL(param_name, "prefetch_depth"))
 	{
-	  if (param->type != json_integer || param->u.integer < 0)
+	  if (param->type != json_integer || param->u.integer < 1)
 	    {
-	      strcat(errmsg_acc,
-		     "inter_test_delay must be a positive integer\n");
+	      ERRMSG("prefetch_depth must be greater than zero\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->inter_test_delay = param->u.integer;
+	      iore_params->prefetch_depth = param->u.integer;
 	    }
 	}
-      else if (STREQUAL(param_name, "intra_test_barrier"))
+      else if (STREQUAL(param_name, "record_size"))
 	{
-	  if (param->type != json_boolean)
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) <= 0)
 	    {
-	      strcat(errmsg_acc,
-		     "intra_test_barrier must either true or false\n");
+	      ERRMSG("record_size must be a size greater than "
+		     "zero, e.g. \"4K\"\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->intra_test_barrier = param->u.boolean;
+	      iore_params->record_size = string_to_bytes(param->u.string.ptr);
 	    }
 	}
-      else if (STREQUAL(param_name, "run_time_limit"))
+      else if (STREQUAL(param_name, "records_per_task"))
 	{
-	  if (param->type != json_integer || param->u.integer < 0)
+	  if (param->type != json_integer || param->u.integer < 1)
 	    {
-	      strcat(errmsg_acc, "run_time_limit must be a positive integer\n");
+	      ERRMSG("records_per_task must be greater than zero\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->run_time_limit = param->u.integer;
+	      iore_params->records_per_task = param->u.integer;
 	    }
 	}
-      else if (STREQUAL(param_name, "keep_file"))
+      else if (STREQUAL(param_name, "appenders_per_file"))
 	{
-	  if (param->type != json_boolean)
+	  if (param->type != json_integer || param->u.integer < 0)
 	    {
-	      strcat(errmsg_acc, "keep_file must be either true of false\n");
+	      ERRMSG("appenders_per_file must not be negative\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->keep_file = param->u.boolean;
+	      iore_params->appenders_per_file = param->u.integer;
 	    }
 	}
-      else if (STREQUAL(param_name, "use_existing_file"))
+      else if (STREQUAL(param_name, "files_per_task"))
 	{
-	  if (param->type != json_boolean)
+	  if (param->type != json_integer || param->u.integer < 1)
 	    {
-	      strcat(errmsg_acc,
-		     "use_exiting_file must be either true of false\n");
+	      ERRMSG("files_per_task must be greater than zero\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->use_existing_file = param->u.boolean;
+	      iore_params->files_per_task = param->u.integer;
 	    }
 	}
-      else if (STREQUAL(param_name, "use_rep_in_file_name"))
+      else if (STREQUAL(param_name, "file_size_distribution"))
 	{
-	  if (param->type != json_boolean)
+	  if (param->type != json_string ||
+	      !(STREQUAL(param->u.string.ptr, "FIXED") ||
+		STREQUAL(param->u.string.ptr, "UNIFORM") ||
+		STREQUAL(param->u.string.ptr, "LOGNORMAL") ||
+		STREQUAL(param->u.string.ptr, "EMPIRICAL")))
 	    {
-	      strcat(errmsg_acc,
-		     "use_rep_in_file_name must be either true of false\n");
+	      ERRMSG("file_size_distribution must be either \"FIXED\", "
+		     "\"UNIFORM\", \"LOGNORMAL\" or \"EMPIRICAL\"\n");
 	      num_errors++;
 	    }
+	  else if (STREQUAL(param->u.string.ptr, "FIXED"))
+	    iore_params->file_size_distribution = FIXED_SIZE;
+	  else if (STREQUAL(param->u.string.ptr, "UNIFORM"))
+	    iore_params->file_size_distribution = UNIFORM_SIZE;
+	  else if (STREQUAL(param->u.string.ptr, "LOGNORMAL"))
+	    iore_params->file_size_distribution = LOGNORMAL_SIZE;
 	  else
+	    iore_params->file_size_distribution = EMPIRICAL_SIZE;
+	}
+      else if (STREQUAL(param_name, "file_size"))
+	{
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) <= 0)
 	    {
-	      iore_params->use_rep_in_file_name = param->u.boolean;
+	      ERRMSG("file_size must be a size greater than zero, "
+		     "e.g. \"4K\"\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->file_size = string_to_bytes(param->u.string.ptr);
 	    }
 	}
-      else if (STREQUAL(param_name, "dir_per_file"))
+      else if (STREQUAL(param_name, "max_file_size"))
 	{
-	  if (param->type != json_boolean)
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) < 0)
 	    {
-	      strcat(errmsg_acc, "dir_per_file must be either true of false\n");
+	      ERRMSG("max_file_size must be a size, e.g. "
+		     "\"1M\"\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->dir_per_file = param->u.boolean;
+	      iore_params->max_file_size = string_to_bytes(param->u.string.ptr);
 	    }
 	}
-      else if (STREQUAL(param_name, "reorder_tasks"))
+      else if (STREQUAL(param_name, "file_size_sigma"))
 	{
-	  if (param->type != json_boolean)
+	  if (!get_number(param, &number) || number <= 0)
 	    {
-	      strcat(errmsg_acc,
-		     "reorder_tasks must be either true of false\n");
+	      ERRMSG("file_size_sigma must be greater than zero\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->reorder_tasks = param->u.boolean;
+	      iore_params->file_size_sigma = number;
 	    }
 	}
-      else if (STREQUAL(param_name, "reorder_tasks_offset"))
+      else if (STREQUAL(param_name, "file_size_histogram"))
 	{
-	  if (param->type != json_integer || param->u.integer < 0)
+	  if (param->type != json_string ||
+	      param->u.string.length >= MAXPATHLEN)
 	    {
-	      strcat(errmsg_acc,
-		     "reorder_tasks_offset must be a positive integer\n");
+	      ERRMSG("file_size_histogram must be a string\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->reorder_tasks_offset = param->u.integer;
+	      strcpy(iore_params->file_size_histogram, param->u.string.ptr);
 	    }
 	}
-      else if (STREQUAL(param_name, "single_io_attempt"))
+      else if (STREQUAL(param_name, "sharing_policy"))
 	{
-	  if (param->type != json_boolean)
+	  if (param->type != json_string ||
+	      !(STREQUAL(param->u.string.ptr, "SHARED_FILE") ||
+		STREQUAL(param->u.string.ptr, "FILE_PER_PROCESS")))
 	    {
-	      strcat(errmsg_acc,
-		     "single_io_attempt must be either true or false\n");
+	      ERRMSG("sharing_policy must be either \"SHARED_FILE\""
+		     "or \"FILE_PER_PROCESS\"\n");
 	      num_errors++;
 	    }
 	  else
 	    {
-	      iore_params->single_io_attempt = param->u.boolean;
+	      iore_params->sharing_policy = STREQUAL(param->u.string.ptr,
+						     "SHARED_FILE") ?
+		SHARED_FILE : FILE_PER_PROCESS;
 	    }
 	}
-    } /* end of loop over parameters */
-
-  if (num_errors > 0)
-    {
-      ERRF("Errors were found in the parameters definitions:\n%s", errmsg_acc);
-      MPI_Abort(MPI_COMM_WORLD, -1);
-    }
-} /* parse_file_params (json_value *, iore_params_t *) */
-
-/*
+      else if (STREQUAL(param_name, "access_pattern"))
+	{
+	  if (param->type != json_string ||
+	      !(STREQUAL(param->u.string.ptr, "SEQUENTIAL") ||
+		STREQUAL(param->u.string.ptr, "RANDOM") ||
+		STREQUAL(param->u.string.ptr, "ZIPFIAN") ||
+		STREQUAL(param->u.string.ptr, "HOTSPOT") ||
+		STREQUAL(param->u.string.ptr, "GAUSSIAN") ||
+		STREQUAL(param->u.string.ptr, "REVERSE") ||
+		STREQUAL(param->u.string.ptr, "STRIDED")))
+	    {
+	      ERRMSG("access_pattern must be either \"SEQUENTIAL\", "
+		     "\"RANDOM\", \"ZIPFIAN\", \"HOTSPOT\", \"GAUSSIAN\", "
+		     "\"REVERSE\" or \"STRIDED\"\n");
+	      num_errors++;
+	    }
+	  else if (STREQUAL(param->u.string.ptr, "SEQUENTIAL"))
+	    iore_params->access_pattern = SEQUENTIAL;
+	  else if (STREQUAL(param->u.string.ptr, "RANDOM"))
+	    iore_params->access_pattern = RANDOM;
+	  else if (STREQUAL(param->u.string.ptr, "ZIPFIAN"))
+	    iore_params->access_pattern = ZIPFIAN;
+	  else if (STREQUAL(param->u.string.ptr, "HOTSPOT"))
+	    iore_params->access_pattern = HOTSPOT;
+	  else if (STREQUAL(param->u.string.ptr, "GAUSSIAN"))
+	    iore_params->access_pattern = GAUSSIAN;
+	  else if (STREQUAL(param->u.string.ptr, "REVERSE"))
+	    iore_params->access_pattern = REVERSE;
+	  else
+	    iore_params->access_pattern = STRIDED;
+	}
+      else if (STREQUAL(param_name, "access_stride"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("access_stride must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->access_stride = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "zipf_theta"))
+	{
+	  if (!get_number(param, &number) || number <= 0)
+	    {
+	      ERRMSG("zipf_theta must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->zipf_theta = number;
+	    }
+	}
+      else if (STREQUAL(param_name, "hot_fraction"))
+	{
+	  if (!get_number(param, &number) || number <= 0 || number > 1)
+	    {
+	      ERRMSG("hot_fraction must be in (0, 1]\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->hot_fraction = number;
+	    }
+	}
+      else if (STREQUAL(param_name, "hot_access_fraction"))
+	{
+	  if (!get_number(param, &number) || number < 0 || number > 1)
+	    {
+	      ERRMSG("hot_access_fraction must be in [0, 1]\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->hot_access_fraction = number;
+	    }
+	}
+      else if (STREQUAL(param_name, "gaussian_stddev"))
+	{
+	  if (!get_number(param, &number) || number <= 0)
+	    {
+	      ERRMSG("gaussian_stddev must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->gaussian_stddev = number;
+	    }
+	}
+      else if (STREQUAL(param_name, "file_layout"))
+	{
+	  if (param->type != json_string ||
+	      !(STREQUAL(param->u.string.ptr, "CONTIGUOUS") ||
+		STREQUAL(param->u.string.ptr, "SEGMENTED") ||
+		STREQUAL(param->u.string.ptr, "INTERLEAVED") ||
+		STREQUAL(param->u.string.ptr, "LOG_STRUCTURED")))
+	    {
+	      ERRMSG("file_layout must be either \"CONTIGUOUS\", "
+		     "\"SEGMENTED\", \"INTERLEAVED\" or \"LOG_STRUCTURED\"\n");
+	      num_errors++;
+	    }
+	  else if (STREQUAL(param->u.string.ptr, "CONTIGUOUS"))
+	    iore_params->file_layout = CONTIGUOUS;
+	  else if (STREQUAL(param->u.string.ptr, "SEGMENTED"))
+	    iore_params->file_layout = SEGMENTED;
+	  else if (STREQUAL(param->u.string.ptr, "INTERLEAVED"))
+	    iore_params->file_layout = INTERLEAVED;
+	  else
+	    iore_params->file_layout = LOG_STRUCTURED;
+	}
+      else if (STREQUAL(param_name, "segment_count"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("segment_count must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->segment_count = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "block_sizes"))
+	{
+	  if (param->type == json_integer)
+	    {
+	      if (param->u.integer < 1)
+		{
+		  ERRMSG("block_sizes must be greater than 0\n");
+		  num_errors++;
+		}
+	      else
+		{
+		  iore_params->block_sizes =
+		    (iore_size_t *) malloc(sizeof(iore_size_t));
+		  iore_params->block_sizes[0] = param->u.integer;
+		  iore_params->block_sizes_length = 1;
+		}
+	    }
+	  else if (param->type == json_string)
+	    {
+	      iore_params->block_sizes =
+		(iore_size_t *) malloc(sizeof(iore_size_t));
+
+	      if ((iore_params->block_sizes[0] =
+		   string_to_bytes(param->u.string.ptr)) < 1)
+		{
+		  ERRMSG("block_sizes must be greater than 0\n");
+		  num_errors++;
+		}
+	      iore_params->block_sizes_length = 1;
+	    }
+	  else if (param->type == json_array)
+	    {
+	      length = param->u.array.length;
+	      iore_params->block_sizes =
+		(iore_size_t *) malloc(length * sizeof(iore_size_t));
+
+	      for (j = 0; j < length; j++)
+		{
+		  value = param->u.array.values[j];
+		  if (value->type == json_integer)
+		    {
+		      if (value->u.integer < 1)
+			{
+			  ERRMSG("block_sizes must be greater than 0\n");
+			  num_errors++;
+			}
+		      else
+			{
+			  iore_params->block_sizes[j] = value->u.integer;
+			}
+		    }
+		  else if (value->type == json_string)
+		    {
+		      if ((iore_params->block_sizes[j] =
+			   string_to_bytes(value->u.string.ptr)) < 1)
+			{
+			  ERRMSG("block_sizes must be greater than 0\n");
+			  num_errors++;
+			}
+		    }
+		  else
+		    {
+		      ERRMSG("block_sizes must be "
+			     "by an integer number of bytes, "
+			     "or a string formed by an integer plus a unit\n");
+		      num_errors++;
+		    }
+		}
+	      iore_params->block_sizes_length = length;
+	    }
+	  else
+	    {
+	      ERRMSG("block_sizes must be "
+		     "an integer number of bytes, "
+		     "a string formed by an integer plus a unit, "
+		     "or an array of integers or of integers plus units\n");
+	      num_errors++;
+	    }
+	}
+      else if (STREQUAL(param_name, "transfer_sizes"))
+	{
+	  if (param->type == json_integer)
+	    {
+	      if (param->u.integer < 1)
+		{
+		  ERRMSG("transfer_sizes must be greater than 0\n");
+		  num_errors++;
+		}
+	      else
+		{
+		  iore_params->transfer_sizes =
+		    (iore_size_t *) malloc(sizeof(iore_size_t));
+		  iore_params->transfer_sizes[0] = param->u.integer;
+		  iore_params->transfer_sizes_length = 1;
+		}
+	    }
+	  else if (param->type == json_string)
+	    {
+	      iore_params->transfer_sizes =
+		(iore_size_t *) malloc(sizeof(iore_size_t));
+
+	      if ((iore_params->transfer_sizes[0] =
+		   string_to_bytes(param->u.string.ptr)) < 1)
+		{
+		  ERRMSG("transfer_sizes must be greater than 0\n");
+		  num_errors++;
+		}
+	      iore_params->transfer_sizes_length = 1;
+	    }
+	  else if (param->type == json_array)
+	    {
+	      length = param->u.array.length;
+	      iore_params->transfer_sizes =
+		(iore_size_t *) malloc(length * sizeof(iore_size_t));
+
+	      for (j = 0; j < length; j++)
+		{
+		  value = param->u.array.values[j];
+		  if (value->type == json_integer)
+		    {
+		      if (value->u.integer < 1)
+			{
+			  ERRMSG("transfer_sizes must be greater than 0\n");
+			  num_errors++;
+			}
+		      else
+			{
+			  iore_params->transfer_sizes[j] = value->u.integer;
+			}
+		    }
+		  else if (value->type == json_string)
+		    {
+		      if ((iore_params->transfer_sizes[j] =
+			   string_to_bytes(value->u.string.ptr)) < 1)
+			{
+			  ERRMSG("transfer_sizes must be greater than 0\n");
+			  num_errors++;
+			}
+		    }
+		  else
+		    {
+		      ERRMSG("transfer_sizes must be "
+			     "by an integer number of bytes, "
+			     "or a string formed by an integer plus a unit\n");
+		      num_errors++;
+		    }
+		}
+	      iore_params->transfer_sizes_length = length;
+	    }
+	  else
+	    {
+	      ERRMSG("transfer_sizes must be "
+		     "an integer number of bytes, "
+		     "a string formed by an integer plus a unit, "
+		     "or an array of integers or of integers plus units\n");
+	      num_errors++;
+	    }
+	}
+      else if (STREQUAL(param_name, "write_test"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("write_test must be either true or false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->write_test = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "read_test"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("read_test must be either true or false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->read_test = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "mixed_test"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("mixed_test must be either true or false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->mixed_test = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "tree_depth"))
+	{
+	  if (param->type != json_integer || param->u.integer < 0)
+	    {
+	      ERRMSG("tree_depth must not be negative\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->tree_depth = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "tree_fanout"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("tree_fanout must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->tree_fanout = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "items_per_dir"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("items_per_dir must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->items_per_dir = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "unique_dir_per_task"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("unique_dir_per_task must be either true of false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->unique_dir_per_task = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "visibility_records"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("visibility_records must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->visibility_records = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "visibility_timeout"))
+	{
+	  if (!get_number(param, &number) || number <= 0)
+	    {
+	      ERRMSG("visibility_timeout must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->visibility_timeout = number;
+	    }
+	}
+      else if (STREQUAL(param_name, "preallocation"))
+	{
+	  if (param->type != json_string ||
+	      !(STREQUAL(param->u.string.ptr, "NONE") ||
+		STREQUAL(param->u.string.ptr, "FALLOCATE") ||
+		STREQUAL(param->u.string.ptr, "SPARSE")))
+	    {
+	      ERRMSG("preallocation must be either \"NONE\", \"FALLOCATE\" or "
+		     "\"SPARSE\"\n");
+	      num_errors++;
+	    }
+	  else if (STREQUAL(param->u.string.ptr, "NONE"))
+	    iore_params->preallocation = NO_PREALLOCATION;
+	  else if (STREQUAL(param->u.string.ptr, "FALLOCATE"))
+	    iore_params->preallocation = FALLOCATE;
+	  else
+	    iore_params->preallocation = SPARSE_FILE;
+	}
+      else if (STREQUAL(param_name, "durability"))
+	{
+	  if (param->type != json_string ||
+	      !(STREQUAL(param->u.string.ptr, "NONE") ||
+		STREQUAL(param->u.string.ptr, "FSYNC") ||
+		STREQUAL(param->u.string.ptr, "FSYNC_INTERVAL") ||
+		STREQUAL(param->u.string.ptr, "FDATASYNC") ||
+		STREQUAL(param->u.string.ptr, "O_DSYNC") ||
+		STREQUAL(param->u.string.ptr, "O_SYNC") ||
+		STREQUAL(param->u.string.ptr, "SYNC_FILE_RANGE")))
+	    {
+	      ERRMSG("durability must be either \"NONE\", \"FSYNC\", "
+		     "\"FSYNC_INTERVAL\", \"FDATASYNC\", \"O_DSYNC\", "
+		     "\"O_SYNC\" or \"SYNC_FILE_RANGE\"\n");
+	      num_errors++;
+	    }
+	  else if (STREQUAL(param->u.string.ptr, "NONE"))
+	    iore_params->durability = NO_DURABILITY;
+	  else if (STREQUAL(param->u.string.ptr, "FSYNC"))
+	    iore_params->durability = FSYNC;
+	  else if (STREQUAL(param->u.string.ptr, "FSYNC_INTERVAL"))
+	    iore_params->durability = FSYNC_INTERVAL;
+	  else if (STREQUAL(param->u.string.ptr, "FDATASYNC"))
+	    iore_params->durability = FDATASYNC;
+	  else if (STREQUAL(param->u.string.ptr, "O_DSYNC"))
+	    iore_params->durability = DSYNC_OPEN;
+	  else if (STREQUAL(param->u.string.ptr, "O_SYNC"))
+	    iore_params->durability = SYNC_OPEN;
+	  else
+	    iore_params->durability = SYNC_FILE_RANGE;
+	}
+      else if (STREQUAL(param_name, "drop_cache_before_read"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("drop_cache_before_read must be either true "
+		     "of false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->drop_cache_before_read = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "sync_interval"))
+	{
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) <= 0)
+	    {
+	      ERRMSG("sync_interval must be a size, e.g. "
+		     "\"64M\"\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->sync_interval = string_to_bytes(param->u.string.ptr);
+	    }
+	}
+      else if (STREQUAL(param_name, "punch_holes"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("punch_holes must be either true of false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->punch_holes = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "open_files_per_task"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("open_files_per_task must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->open_files_per_task = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "open_file_selection"))
+	{
+	  if (param->type != json_string ||
+	      !(STREQUAL(param->u.string.ptr, "ROUND_ROBIN") ||
+		STREQUAL(param->u.string.ptr, "RANDOM")))
+	    {
+	      ERRMSG("open_file_selection must be either \"ROUND_ROBIN\" or "
+		     "\"RANDOM\"\n");
+	      num_errors++;
+	    }
+	  else if (STREQUAL(param->u.string.ptr, "ROUND_ROBIN"))
+	    iore_params->open_file_selection = ROUND_ROBIN_FILES;
+	  else
+	    iore_params->open_file_selection = RANDOM_FILES;
+	}
+      else if (STREQUAL(param_name, "dirty_fraction"))
+	{
+	  if (!get_number(param, &number) || number <= 0 || number > 1)
+	    {
+	      ERRMSG("dirty_fraction must be in (0, 1]\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->dirty_fraction = number;
+	    }
+	}
+      else if (STREQUAL(param_name, "dirty_selection"))
+	{
+	  if (param->type != json_string ||
+	      !(STREQUAL(param->u.string.ptr, "SCATTERED") ||
+		STREQUAL(param->u.string.ptr, "CLUSTERED")))
+	    {
+	      ERRMSG("dirty_selection must be either \"SCATTERED\" or "
+		     "\"CLUSTERED\"\n");
+	      num_errors++;
+	    }
+	  else if (STREQUAL(param->u.string.ptr, "SCATTERED"))
+	    iore_params->dirty_selection = SCATTERED;
+	  else
+	    iore_params->dirty_selection = CLUSTERED;
+	}
+      else if (STREQUAL(param_name, "dirty_cluster_size"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("dirty_cluster_size must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->dirty_cluster_size = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "update_test"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("update_test must be either true or false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->update_test = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "update_size"))
+	{
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) < 0)
+	    {
+	      ERRMSG("update_size must be a size, e.g. \"1K\"\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->update_size = string_to_bytes(param->u.string.ptr);
+	    }
+	}
+      else if (STREQUAL(param_name, "fs_block_size"))
+	{
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) <= 0)
+	    {
+	      ERRMSG("fs_block_size must be a size greater than "
+		     "zero, e.g. \"4K\"\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->fs_block_size = string_to_bytes(param->u.string.ptr);
+	    }
+	}
+      else if (STREQUAL(param_name, "stripe_size"))
+	{
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) <= 0)
+	    {
+	      ERRMSG("stripe_size must be a size greater than "
+		     "zero, e.g. \"1M\"\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->stripe_size = string_to_bytes(param->u.string.ptr);
+	    }
+	}
+      else if (STREQUAL(param_name, "misalignment"))
+	{
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) < 0)
+	    {
+	      ERRMSG("misalignment must be a size, e.g. "
+		     "\"512\"\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->misalignment = string_to_bytes(param->u.string.ptr);
+	    }
+	}
+      else if (STREQUAL(param_name, "misalignment_steps"))
+	{
+	  if (param->type != json_integer || param->u.integer < 0)
+	    {
+	      ERRMSG("misalignment_steps must be a non-negative "
+		     "integer\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->misalignment_steps = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "read_fraction"))
+	{
+	  if (!get_number(param, &number) || number < 0 || number > 1)
+	    {
+	      ERRMSG("read_fraction must be in [0, 1]\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->read_fraction = number;
+	    }
+	}
+      else if (STREQUAL(param_name, "arrival_process"))
+	{
+	  if (param->type != json_string ||
+	      !(STREQUAL(param->u.string.ptr, "CLOSED_LOOP") ||
+		STREQUAL(param->u.string.ptr, "FIXED_RATE") ||
+		STREQUAL(param->u.string.ptr, "POISSON") ||
+		STREQUAL(param->u.string.ptr, "BURSTY")))
+	    {
+	      ERRMSG("arrival_process must be either \"CLOSED_LOOP\", "
+		     "\"FIXED_RATE\", \"POISSON\" or \"BURSTY\"\n");
+	      num_errors++;
+	    }
+	  else if (STREQUAL(param->u.string.ptr, "CLOSED_LOOP"))
+	    iore_params->arrival_process = CLOSED_LOOP;
+	  else if (STREQUAL(param->u.string.ptr, "FIXED_RATE"))
+	    iore_params->arrival_process = FIXED_RATE;
+	  else if (STREQUAL(param->u.string.ptr, "POISSON"))
+	    iore_params->arrival_process = POISSON;
+	  else
+	    iore_params->arrival_process = BURSTY;
+	}
+      else if (STREQUAL(param_name, "target_iops"))
+	{
+	  if (!get_number(param, &number) || number <= 0)
+	    {
+	      ERRMSG("target_iops must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->target_iops = number;
+	    }
+	}
+      else if (STREQUAL(param_name, "target_bandwidth"))
+	{
+	  if (param->type != json_string ||
+	      string_to_bytes(param->u.string.ptr) <= 0)
+	    {
+	      ERRMSG("target_bandwidth must be a size per second "
+		     "greater than zero, e.g. \"100M\"\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->target_bandwidth =
+		string_to_bytes(param->u.string.ptr);
+	    }
+	}
+      else if (STREQUAL(param_name, "burst_size"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("burst_size must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->burst_size = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "queue_depth"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("queue_depth must be greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->queue_depth = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "max_queue_depth"))
+	{
+	  if (param->type != json_integer || param->u.integer < 0)
+	    {
+	      ERRMSG("max_queue_depth must be a positive integer\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->max_queue_depth = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "ref_num"))
+	{
+	  if (param->type != json_integer)
+	    {
+	      ERRMSG("ref_num must be an integer\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->ref_num = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "root_file_name"))
+	{
+	  if (param->type != json_string)
+	    {
+	      ERRMSG("root_file_name must be a string\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      strcpy(iore_params->root_file_name, param->u.string.ptr);
+	    }
+	}
+      else if (STREQUAL(param_name, "num_repetitions"))
+	{
+	  if (param->type != json_integer || param->u.integer < 1)
+	    {
+	      ERRMSG("num_repetitions must be a greater than zero\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->num_repetitions = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "inter_test_delay"))
+	{
+	  if (param->type != json_integer || param->u.integer < 0)
+	    {
+	      ERRMSG("inter_test_delay must be a positive integer\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->inter_test_delay = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "intra_test_barrier"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("intra_test_barrier must either true or false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->intra_test_barrier = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "run_time_limit"))
+	{
+	  if (param->type != json_integer || param->u.integer < 0)
+	    {
+	      ERRMSG("run_time_limit must be a positive integer\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->run_time_limit = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "stonewall"))
+	{
+	  if (param->type != json_integer || param->u.integer < 0)
+	    {
+	      ERRMSG("stonewall must be a positive integer\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->stonewall = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "keep_file"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("keep_file must be either true of false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->keep_file = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "use_existing_file"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("use_exiting_file must be either true of false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->use_existing_file = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "use_rep_in_file_name"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("use_rep_in_file_name must be either true of false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->use_rep_in_file_name = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "dir_per_file"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("dir_per_file must be either true of false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->dir_per_file = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "reorder_tasks"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("reorder_tasks must be either true of false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->reorder_tasks = param->u.boolean;
+	    }
+	}
+      else if (STREQUAL(param_name, "reorder_tasks_offset"))
+	{
+	  if (param->type != json_integer || param->u.integer < 0)
+	    {
+	      ERRMSG("reorder_tasks_offset must be a positive integer\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->reorder_tasks_offset = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "random_seed"))
+	{
+	  if (param->type != json_integer || param->u.integer < 0)
+	    {
+	      ERRMSG("random_seed must be a non-negative integer\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->random_seed = param->u.integer;
+	    }
+	}
+      else if (STREQUAL(param_name, "single_io_attempt"))
+	{
+	  if (param->type != json_boolean)
+	    {
+	      ERRMSG("single_io_attempt must be either true or false\n");
+	      num_errors++;
+	    }
+	  else
+	    {
+	      iore_params->single_io_attempt = param->u.boolean;
+	    }
+	}
+    } /* end of loop over parameters */
+
+  if (num_errors > 0)
+    {
+      ERRF(ERRMSG_HEADER "%s", errmsg_acc);
+      MPI_Abort(MPI_COMM_WORLD, -1);
+    }
+} /* parse_file_params (json_value *, iore_params_t *) */
+
+/*
  * Converts a string of the form 2, 4k, 8K, 16m, 32m, 64g, 128G into bytes.
  * Considers base two units.
  */
@@ -697,3 +1578,20 @@ string_to_bytes (char *size_str)
 
   return (size);
 } /* string_to_bytes (char *) */
+
+/*
+ * Get the value of a JSON integer or double number. Returns FALSE if the value
+ * is not a number.
+ */
+static int
+get_number (json_value *value, double *number)
+{
+  if (value->type == json_integer)
+    *number = (double) value->u.integer;
+  else if (value->type == json_double)
+    *number = value->u.dbl;
+  else
+    return (FALSE);
+
+  return (TRUE);
+} /* get_number (json_value *, double *) */
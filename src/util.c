@@ -61,9 +61,9 @@ current_time()
 
 /*
  * Synchronize random number generation across all tasks in an MPI communicator
- * through broadcasting a seed from the master rank.
+ * through broadcasting a seed from the master rank. Returns the seed.
  */
-void
+unsigned int
 sync_rand_gen(MPI_Comm comm)
 {
   unsigned int seed;
@@ -79,6 +79,8 @@ sync_rand_gen(MPI_Comm comm)
 	       "Failed to broadcast the seed for the PRNG");
 
   srandom(seed);
+
+  return (seed);
 } /* sync_rand_gen(MPI_Comm) */
 
 /*